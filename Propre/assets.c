@@ -0,0 +1,246 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "assets.h"
+#include "atlas.h"
+#include "trace.h"
+
+#include <SDL2/SDL_image.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#define FONT_PATH "arial.ttf"
+#define FONT_SIZE 20
+
+typedef enum
+{
+    PAGE_DECODING,
+    PAGE_DECODED,
+    PAGE_FAILED,
+    PAGE_UPLOADED
+} PageState;
+
+// Une page de l'atlas : décodée par son thread, envoyée au renderer par le thread principal
+typedef struct
+{
+    pthread_t thread;
+    bool started;          // thread lancé et pas encore rejoint
+    atomic_int state;      // PageState, publié par le thread de décodage
+    SDL_Surface *surface;  // pixels décodés, jusqu'à l'envoi
+    SDL_Texture *texture;  // touchée seulement par le thread principal
+    char error[256];       // les erreurs de SDL_image sont propres au thread qui les a eues
+} Page;
+
+static Page pages[ATLAS_PAGE_COUNT];
+static bool decodingStarted = false;
+static Uint32 decodedEvent = (Uint32)-1; // réveille la boucle principale quand une page est décodée
+static TTF_Font *font = NULL;
+static bool imgReady = false;
+static bool ttfReady = false;
+
+static void *decodePage(void *arg)
+{
+    Page *page = arg;
+    const char *path = atlasImages[page - pages];
+    page->surface = IMG_Load(path);
+    if (page->surface == NULL)
+    {
+        snprintf(page->error, sizeof(page->error), "Unable to load image %s! SDL_image Error: %s", path, IMG_GetError());
+    }
+    atomic_store(&page->state, page->surface != NULL ? PAGE_DECODED : PAGE_FAILED);
+
+    // La boucle principale dort dans SDL_WaitEventTimeout : l'envoi au renderer n'attend pas son réveil.
+    // Avant SDL_Init, la file n'existe pas encore et l'événement est perdu, mais la boucle n'a pas commencé.
+    if (decodedEvent != (Uint32)-1)
+    {
+        SDL_Event event = {.type = decodedEvent};
+        SDL_PushEvent(&event);
+    }
+    return NULL;
+}
+
+bool assetsStartDecoding(void)
+{
+    if (decodingStarted)
+    {
+        return true;
+    }
+    // Chargement du décodeur PNG ici, une fois, plutôt qu'à la demande dans plusieurs threads à la fois
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+    {
+        fprintf(stderr, "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        return false;
+    }
+    imgReady = true;
+    decodingStarted = true;
+    decodedEvent = SDL_RegisterEvents(1);
+
+    for (int p = 0; p < ATLAS_PAGE_COUNT; p++)
+    {
+        atomic_init(&pages[p].state, PAGE_DECODING);
+        // Sans thread, la page sera décodée par le premier assetsWait qui la demande
+        pages[p].started = pthread_create(&pages[p].thread, NULL, decodePage, &pages[p]) == 0;
+    }
+    return true;
+}
+
+// Rejoint le thread de la page (ou la décode sur place s'il n'a pas pu être lancé), puis l'envoie
+static bool uploadPage(SDL_Renderer *renderer, Page *page)
+{
+    if (page->started)
+    {
+        pthread_join(page->thread, NULL);
+        page->started = false;
+    }
+    else if (atomic_load(&page->state) == PAGE_DECODING)
+    {
+        decodePage(page);
+    }
+
+    switch (atomic_load(&page->state))
+    {
+    case PAGE_UPLOADED:
+        return true;
+    case PAGE_FAILED:
+        TRACE_ERREUR(TRACE_RENDU, "%s", page->error);
+        fprintf(stderr, "%s\n", page->error);
+        return false;
+    default:
+        break;
+    }
+
+    page->texture = SDL_CreateTextureFromSurface(renderer, page->surface);
+    SDL_FreeSurface(page->surface);
+    page->surface = NULL;
+    if (page->texture == NULL)
+    {
+        snprintf(page->error, sizeof(page->error), "Unable to create texture from %s! SDL Error: %s", atlasImages[page - pages], SDL_GetError());
+        atomic_store(&page->state, PAGE_FAILED);
+        TRACE_ERREUR(TRACE_RENDU, "%s", page->error);
+        fprintf(stderr, "%s\n", page->error);
+        return false;
+    }
+    atomic_store(&page->state, PAGE_UPLOADED);
+    return true;
+}
+
+bool assetsLoad(SDL_Renderer *renderer)
+{
+    if (!assetsStartDecoding())
+    {
+        return false;
+    }
+
+    if (TTF_Init() == -1)
+    {
+        fprintf(stderr, "SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
+        return false;
+    }
+    ttfReady = true;
+
+    font = TTF_OpenFont(FONT_PATH, FONT_SIZE);
+    if (font == NULL)
+    {
+        fprintf(stderr, "Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
+        return false;
+    }
+
+    // Le menu ne peut pas s'afficher sans sa page ; celle du jeu continue de se décoder
+    return assetsWait(renderer, ATLAS_PAGE_MENU);
+}
+
+bool assetsPoll(SDL_Renderer *renderer, bool *uploaded)
+{
+    bool ok = true;
+    for (int p = 0; p < ATLAS_PAGE_COUNT; p++)
+    {
+        int state = atomic_load(&pages[p].state);
+        if (state == PAGE_DECODED && uploadPage(renderer, &pages[p]))
+        {
+            if (uploaded != NULL)
+            {
+                *uploaded = true;
+            }
+        }
+        else if (state == PAGE_FAILED && pages[p].started)
+        {
+            ok = uploadPage(renderer, &pages[p]) && ok; // rejoint le thread et signale l'erreur, une fois
+        }
+        else if (state != PAGE_DECODING && state != PAGE_UPLOADED)
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool assetsWait(SDL_Renderer *renderer, AtlasPage page)
+{
+    if (!assetsStartDecoding())
+    {
+        return false;
+    }
+    return uploadPage(renderer, &pages[page]);
+}
+
+bool assetsPageReady(AtlasPage page)
+{
+    return pages[page].texture != NULL;
+}
+
+void assetsFree(void)
+{
+    for (int p = 0; p < ATLAS_PAGE_COUNT; p++)
+    {
+        if (pages[p].started)
+        {
+            pthread_join(pages[p].thread, NULL);
+            pages[p].started = false;
+        }
+        if (pages[p].surface != NULL)
+        {
+            SDL_FreeSurface(pages[p].surface);
+            pages[p].surface = NULL;
+        }
+        if (pages[p].texture != NULL)
+        {
+            SDL_DestroyTexture(pages[p].texture);
+            pages[p].texture = NULL;
+        }
+    }
+    decodingStarted = false;
+    if (font != NULL)
+    {
+        TTF_CloseFont(font);
+        font = NULL;
+    }
+    if (ttfReady)
+    {
+        TTF_Quit();
+        ttfReady = false;
+    }
+    if (imgReady)
+    {
+        IMG_Quit();
+        imgReady = false;
+    }
+}
+
+void assetDraw(SDL_Renderer *renderer, TextureId id, const SDL_Rect *dst)
+{
+    SDL_Texture *page = pages[atlasPages[id]].texture;
+    if (page != NULL)
+    {
+        SDL_RenderCopy(renderer, page, &atlasRects[id], dst);
+    }
+}
+
+void assetDrawObject(SDL_Renderer *renderer, Object object, const SDL_Rect *dst)
+{
+    assetDraw(renderer, (TextureId)(TEXTURE_CIGARETTE + object), dst);
+}
+
+TTF_Font *assetFont(void)
+{
+    return font;
+}
@@ -0,0 +1,68 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+// Gestionnaire de ressources : toutes les images et la police sont chargées une seule fois
+// au démarrage, partagées par le menu, le tableau des scores et toutes les parties,
+// et libérées seulement à la fermeture du programme.
+//
+// Les images sont rangées dans un atlas de deux pages (images/atlas_menu.png et
+// images/atlas_jeu.png, construites par « make atlas ») : chaque dessin est une copie d'un
+// sous-rectangle de la texture de sa page, que le renderer peut regrouper en un seul lot.
+//
+// Le décodage des PNG se fait sur des threads de fond lancés dès le début du processus ;
+// seul l'envoi des pixels au renderer a lieu sur le thread principal. Le menu s'affiche dès
+// que sa page est prête, la page du jeu arrive pendant ce temps.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+
+#include "regles.h"
+
+typedef enum
+{
+    TEXTURE_TITLE,
+    TEXTURE_LAUNCH_BUTTON,
+    TEXTURE_SCOREBOARD_BUTTON,
+    TEXTURE_QUIT_BUTTON,
+    TEXTURE_RETURN,
+    TEXTURE_POMPE,
+    // Les objets suivent dans l'ordre de l'énumération Object
+    TEXTURE_CIGARETTE,
+    TEXTURE_BIERE,
+    TEXTURE_LOUPE,
+    TEXTURE_PILLULES,
+    TEXTURE_COUNT
+} TextureId;
+
+typedef enum
+{
+    ATLAS_PAGE_MENU, // titre et boutons : nécessaire à la première image
+    ATLAS_PAGE_GAME, // pompe et objets : nécessaire seulement en partie
+    ATLAS_PAGE_COUNT
+} AtlasPage;
+
+// Lance le décodage de toutes les pages en fond ; à appeler le plus tôt possible, avant SDL_Init
+bool assetsStartDecoding(void);
+
+// Police, puis page du menu envoyée au renderer (attend la fin de son décodage si besoin)
+bool assetsLoad(SDL_Renderer *renderer);
+
+// Envoie au renderer les pages décodées depuis le dernier appel, sans jamais attendre.
+// Chaque page décodée pousse un événement SDL qui réveille la boucle endormie dans SDL_WaitEventTimeout.
+// *uploaded (si non NULL) : au moins une page vient d'arriver, l'écran est à redessiner.
+// false si le décodage d'une page a échoué.
+bool assetsPoll(SDL_Renderer *renderer, bool *uploaded);
+
+// Attend le décodage de la page puis l'envoie : pour un écran qui ne peut pas s'en passer
+bool assetsWait(SDL_Renderer *renderer, AtlasPage page);
+
+bool assetsPageReady(AtlasPage page);
+void assetsFree(void);
+
+// Copie l'image id de sa page de l'atlas dans le rectangle dst ; rien tant que la page n'est pas prête
+void assetDraw(SDL_Renderer *renderer, TextureId id, const SDL_Rect *dst);
+void assetDrawObject(SDL_Renderer *renderer, Object object, const SDL_Rect *dst);
+TTF_Font *assetFont(void);
+
+#endif
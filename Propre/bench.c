@@ -0,0 +1,362 @@
+// Micro-benchmarks des règles et de l'affichage : make bench
+//
+// Usage : ./Buckshot_Bench [--csv] [--duree ms]
+//
+// Chaque mesure enchaîne des lots d'opérations (un lot dure environ 20 µs) ; le temps moyen
+// par opération de chaque lot donne un échantillon, d'où les percentiles. Les allocations
+// sont comptées en interceptant malloc/calloc/realloc (glibc uniquement).
+// drawGrid est dessinée hors écran par le renderer logiciel, avec le pilote vidéo « dummy ».
+// --csv : une ligne par mesure, pour comparer deux versions du programme.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "assets.h"
+#include "grid.h"
+#include "ia.h"
+#include "jeu.h"
+#include "politique.h"
+#include "regles.h"
+
+#define LOT_NS 20000.0
+#define MAX_ECHANTILLONS 20000
+#define DUREE_DEFAUT_MS 300
+#define NB_ETATS 1024 // états de départ précalculés, parcourus en boucle
+
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t taille);
+extern void *__libc_calloc(size_t nombre, size_t taille);
+extern void *__libc_realloc(void *ptr, size_t taille);
+
+static unsigned long long allocations = 0;
+
+void *malloc(size_t taille)
+{
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(taille);
+}
+
+void *calloc(size_t nombre, size_t taille)
+{
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(nombre, taille);
+}
+
+void *realloc(void *ptr, size_t taille)
+{
+    __atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, taille);
+}
+
+static unsigned long long compterAllocations(void)
+{
+    return __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+}
+#define ALLOCATIONS_COMPTEES 1
+#else
+static unsigned long long compterAllocations(void)
+{
+    return 0;
+}
+#define ALLOCATIONS_COMPTEES 0
+#endif
+
+typedef struct
+{
+    const char *nom;
+    long long operations;
+    double nsParOp;
+    double allocsParOp;
+    double p50, p90, p99;
+} Resultat;
+
+// Contexte partagé par les opérations mesurées
+static Partie etats[NB_ETATS];
+static Jeu jeux[NB_ETATS];
+static SDL_Point clics[NB_ETATS];
+static Alea alea;
+static volatile uint64_t puits; // empêche le compilateur de supprimer les opérations
+
+static SDL_Surface *cible = NULL;
+static SDL_Renderer *renderer = NULL;
+static GridCell grid[GRID_ROWS][GRID_COLS];
+static GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS];
+static GridCell extraCells[2];
+static SDL_Rect imageRect;
+static HitMap hits;
+static TextCache hud[HUD_LINES];
+
+static double maintenantNs(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static int comparerDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void mesurer(const char *nom, void (*operation)(uint64_t i), double dureeMs, Resultat *resultat)
+{
+    static double echantillons[MAX_ECHANTILLONS];
+    uint64_t i = 0;
+
+    // Étalonnage (sert aussi d'échauffement) : combien d'opérations par lot
+    double debut = maintenantNs();
+    long etalonnage = 0;
+    while (maintenantNs() - debut < 2e6)
+    {
+        operation(i++);
+        etalonnage++;
+    }
+    double estimation = (maintenantNs() - debut) / etalonnage;
+    long lot = (long)(LOT_NS / estimation);
+    if (lot < 1)
+    {
+        lot = 1;
+    }
+
+    int nbEchantillons = 0;
+    long long operations = 0;
+    double total = 0;
+    unsigned long long allocsAvant = compterAllocations();
+    double fin = maintenantNs() + dureeMs * 1e6;
+    while (nbEchantillons < MAX_ECHANTILLONS && (nbEchantillons < 10 || maintenantNs() < fin))
+    {
+        double t0 = maintenantNs();
+        for (long k = 0; k < lot; k++)
+        {
+            operation(i++);
+        }
+        double duree = maintenantNs() - t0;
+        echantillons[nbEchantillons++] = duree / lot;
+        total += duree;
+        operations += lot;
+    }
+    unsigned long long allocs = compterAllocations() - allocsAvant;
+
+    qsort(echantillons, nbEchantillons, sizeof(double), comparerDoubles);
+    resultat->nom = nom;
+    resultat->operations = operations;
+    resultat->nsParOp = total / operations;
+    resultat->allocsParOp = (double)allocs / operations;
+    resultat->p50 = echantillons[nbEchantillons * 50 / 100];
+    resultat->p90 = echantillons[nbEchantillons * 90 / 100];
+    resultat->p99 = echantillons[nbEchantillons * 99 / 100];
+}
+
+static void opGenererBalles(uint64_t i)
+{
+    Partie partie = etats[i % NB_ETATS];
+    genererBalles(&partie, &alea);
+    puits += partie.balles;
+}
+
+static void opDistribuerObjets(uint64_t i)
+{
+    Partie partie = etats[i % NB_ETATS];
+    partie.objets = OBJETS_VIDES;
+    distribuerObjets(&partie, &alea);
+    puits += partie.objets;
+}
+
+static void opTourJoueur(uint64_t i)
+{
+    // Tir du joueur puis tous les tours du dealer qui suivent, comme après un clic
+    Jeu jeu = jeux[i % NB_ETATS];
+    jeuCliquer(&jeu, i & 1 ? CASE_TIR_ADVERSAIRE : CASE_TIR_SOI);
+    puits += jeu.partie.balles;
+}
+
+static void opTourOrdinateurHeuristique(uint64_t i)
+{
+    Partie partie = etats[i % NB_ETATS];
+    tirer(&partie, politiqueHeuristique(&partie, &alea));
+    puits += partie.balles;
+}
+
+static void opTourOrdinateurExpectimax(uint64_t i)
+{
+    // Objets compris, comme le dealer du jeu
+    Partie partie = etats[i % NB_ETATS];
+    Cible cible;
+    if (jouerObjetsExpectimax(&partie, &alea, &cible))
+    {
+        tirer(&partie, cible);
+    }
+    puits += partie.balles;
+}
+
+static void opTourOrdinateurTable(uint64_t i)
+{
+    // Objets compris : chaque décision est une lecture dans la table
+    Partie partie = etats[i % NB_ETATS];
+    Cible cible;
+    if (jouerObjetsTable(&partie, &alea, &cible))
+    {
+        tirer(&partie, cible);
+    }
+    puits += partie.balles;
+}
+
+static void opHandleMouseClick(uint64_t i)
+{
+    SDL_Point p = clics[i % NB_ETATS];
+    puits += (uint64_t)handleMouseClick(&hits, p.x, p.y);
+}
+
+static void opDrawGridStable(uint64_t i)
+{
+    drawGrid(renderer, grid, subgrids, extraCells, assetFont(), hud, &etats[0], &imageRect);
+    puits += i;
+}
+
+static void opDrawGridHudModifie(uint64_t i)
+{
+    // Un état différent à chaque image : le texte du HUD est rendu à nouveau
+    drawGrid(renderer, grid, subgrids, extraCells, assetFont(), hud, &etats[i % NB_ETATS], &imageRect);
+    puits += i;
+}
+
+static void afficher(const Resultat *r, bool csv)
+{
+    if (csv)
+    {
+        printf("%s,%lld,%.2f,%.3f,%.2f,%.2f,%.2f\n", r->nom, r->operations, r->nsParOp,
+               ALLOCATIONS_COMPTEES ? r->allocsParOp : -1.0, r->p50, r->p90, r->p99);
+        return;
+    }
+    printf("%-28s %12.1f ns/op %8.2f allocs/op   p50 %10.1f  p90 %10.1f  p99 %10.1f   (%lld ops)\n",
+           r->nom, r->nsParOp, r->allocsParOp, r->p50, r->p90, r->p99, r->operations);
+}
+
+static void preparerEtats(void)
+{
+    aleaInit(&alea, 12345);
+    for (int i = 0; i < NB_ETATS; i++)
+    {
+        nouvellePartie(&etats[i], &alea);
+        // Quelques tirs pour ne pas mesurer que des débuts de manche
+        int tirs = aleaBorne(&alea, etats[i].nombreDeBalles);
+        for (int t = 0; t < tirs && !mancheTerminee(&etats[i]); t++)
+        {
+            tirer(&etats[i], politiqueHeuristique(&etats[i], &alea));
+        }
+        rechargerSiVide(&etats[i], &alea);
+        if (mancheTerminee(&etats[i]))
+        {
+            debuterManche(&etats[i], &alea);
+        }
+
+        jeuDemarrer(&jeux[i], 1000 + i, politiqueHeuristique, false);
+        clics[i] = (SDL_Point){aleaBorne(&alea, SCREEN_WIDTH), aleaBorne(&alea, SCREEN_HEIGHT)};
+    }
+}
+
+// Renderer logiciel sur une surface en mémoire : aucune fenêtre, aucun GPU
+static bool ouvrirRendererHorsEcran(void)
+{
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) != 0)
+    {
+        fprintf(stderr, "SDL_Init Error: %s\n", SDL_GetError());
+        return false;
+    }
+    cible = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (cible == NULL)
+    {
+        fprintf(stderr, "Surface hors écran impossible : %s\n", SDL_GetError());
+        return false;
+    }
+    renderer = SDL_CreateSoftwareRenderer(cible);
+    if (renderer == NULL)
+    {
+        fprintf(stderr, "Renderer logiciel indisponible : %s\n", SDL_GetError());
+        return false;
+    }
+    // drawGrid dessine depuis la page du jeu : l'attendre pour mesurer de vraies copies
+    return assetsLoad(renderer) && assetsWait(renderer, ATLAS_PAGE_GAME);
+}
+
+int main(int argc, char *argv[])
+{
+    bool csv = false;
+    double dureeMs = DUREE_DEFAUT_MS;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            csv = true;
+        }
+        else if (strcmp(argv[i], "--duree") == 0 && i + 1 < argc)
+        {
+            dureeMs = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage : %s [--csv] [--duree ms]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    preparerEtats();
+    buildGameLayout(grid, subgrids, extraCells, &imageRect, &hits);
+    prechaufferIa();
+
+    if (csv)
+    {
+        printf("benchmark,operations,ns_op,allocs_op,p50_ns,p90_ns,p99_ns\n");
+    }
+
+    Resultat r;
+    mesurer("genererBalles", opGenererBalles, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("distribuerObjets", opDistribuerObjets, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("tour_joueur_et_dealer", opTourJoueur, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("tour_ordinateur_heuristique", opTourOrdinateurHeuristique, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("tour_ordinateur_expectimax", opTourOrdinateurExpectimax, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("tour_ordinateur_table", opTourOrdinateurTable, dureeMs, &r);
+    afficher(&r, csv);
+    mesurer("handleMouseClick", opHandleMouseClick, dureeMs, &r);
+    afficher(&r, csv);
+
+    if (ouvrirRendererHorsEcran())
+    {
+        mesurer("drawGrid", opDrawGridStable, dureeMs, &r);
+        afficher(&r, csv);
+        mesurer("drawGrid_hud_modifie", opDrawGridHudModifie, dureeMs, &r);
+        afficher(&r, csv);
+    }
+    else
+    {
+        fprintf(stderr, "drawGrid non mesurée (images/atlas_*.png ou arial.ttf introuvable ?)\n");
+    }
+
+    freeTextCache(hud, HUD_LINES);
+    assetsFree();
+    if (renderer != NULL)
+    {
+        SDL_DestroyRenderer(renderer);
+    }
+    if (cible != NULL)
+    {
+        SDL_FreeSurface(cible);
+    }
+    SDL_Quit();
+    libererIa();
+    return 0;
+}
@@ -0,0 +1,176 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "chrono.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *nomsEtapes[NB_ETAPES] = {
+    [ETAPE_EVENEMENTS] = "evenements",
+    [ETAPE_REGLES] = "regles",
+    [ETAPE_RECHARGE] = "recharge",
+    [ETAPE_DESSIN] = "dessin",
+    [ETAPE_PRESENTATION] = "presentation",
+    [ETAPE_IMAGE] = "image",
+};
+
+// Cases 0 à 7 : valeurs exactes ; ensuite 8 cases par puissance de 2
+static int caseDe(uint64_t ns)
+{
+    if (ns < CHRONO_SOUS_CASES)
+    {
+        return (int)ns;
+    }
+    int exposant = 63 - __builtin_clzll(ns);
+    int sousCase = (int)(ns >> (exposant - 3)) & (CHRONO_SOUS_CASES - 1);
+    int indice = (exposant - 2) * CHRONO_SOUS_CASES + sousCase;
+    return indice < CHRONO_CASES ? indice : CHRONO_CASES - 1;
+}
+
+static uint64_t debutCase(int indice)
+{
+    if (indice < CHRONO_SOUS_CASES)
+    {
+        return (uint64_t)indice;
+    }
+    int exposant = indice / CHRONO_SOUS_CASES + 2;
+    return (uint64_t)(CHRONO_SOUS_CASES + indice % CHRONO_SOUS_CASES) << (exposant - 3);
+}
+
+static void histogrammeAjouter(Histogramme *histogramme, uint64_t ns)
+{
+    histogramme->cases[caseDe(ns)]++;
+    histogramme->nombre++;
+    histogramme->totalNs += ns;
+    if (ns > histogramme->maxNs)
+    {
+        histogramme->maxNs = ns;
+    }
+}
+
+uint64_t histogrammePercentile(const Histogramme *histogramme, double fraction)
+{
+    if (histogramme->nombre == 0)
+    {
+        return 0;
+    }
+    uint64_t rang = (uint64_t)(fraction * (histogramme->nombre - 1));
+    uint64_t vus = 0;
+    for (int i = 0; i < CHRONO_CASES; i++)
+    {
+        vus += histogramme->cases[i];
+        if (vus > rang && i + 1 < CHRONO_CASES)
+        {
+            // Milieu de la case, sans dépasser le maximum observé
+            uint64_t milieu = (debutCase(i) + debutCase(i + 1)) / 2;
+            return milieu < histogramme->maxNs ? milieu : histogramme->maxNs;
+        }
+    }
+    return histogramme->maxNs;
+}
+
+uint64_t chronoMaintenant(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+void chronoInit(Chronos *chronos)
+{
+    memset(chronos, 0, sizeof(*chronos));
+    chronos->debutFenetre = chronoMaintenant();
+}
+
+void chronoFin(Chronos *chronos, Etape etape, uint64_t debut)
+{
+    if (chronos == NULL)
+    {
+        return;
+    }
+    chronos->enCours[etape] += chronoMaintenant() - debut;
+    chronos->vues |= 1u << etape;
+}
+
+void chronoDebutImage(Chronos *chronos)
+{
+    memset(chronos->enCours, 0, sizeof(chronos->enCours));
+    chronos->vues = 0;
+    chronos->debutImage = chronoMaintenant();
+}
+
+void chronoFinImage(Chronos *chronos)
+{
+    if (chronos->debutImage == 0)
+    {
+        return;
+    }
+    uint64_t duree = chronoMaintenant() - chronos->debutImage;
+    chronos->debutImage = 0;
+
+    // Les événements sont tout ce que les autres étapes n'ont pas mesuré
+    uint64_t mesure = 0;
+    for (int e = ETAPE_REGLES; e < ETAPE_IMAGE; e++)
+    {
+        mesure += chronos->enCours[e];
+    }
+    chronos->enCours[ETAPE_EVENEMENTS] = duree > mesure ? duree - mesure : 0;
+    chronos->enCours[ETAPE_IMAGE] = duree;
+    chronos->vues |= 1u << ETAPE_EVENEMENTS | 1u << ETAPE_IMAGE;
+
+    for (int e = 0; e < NB_ETAPES; e++)
+    {
+        if (chronos->vues & (1u << e))
+        {
+            histogrammeAjouter(&chronos->etapes[e], chronos->enCours[e]);
+        }
+    }
+    histogrammeAjouter(&chronos->fenetre, duree);
+    if (chronos->vues & (1u << ETAPE_PRESENTATION))
+    {
+        chronos->presentees++;
+    }
+}
+
+bool chronoFenetreTerminee(Chronos *chronos)
+{
+    uint64_t maintenant = chronoMaintenant();
+    uint64_t duree = maintenant - chronos->debutFenetre;
+    if (duree < CHRONO_FENETRE_NS)
+    {
+        return false;
+    }
+    chronos->p50Ms = histogrammePercentile(&chronos->fenetre, 0.50) / 1e6;
+    chronos->p99Ms = histogrammePercentile(&chronos->fenetre, 0.99) / 1e6;
+    chronos->imagesParSeconde = chronos->presentees * 1e9 / duree;
+    memset(&chronos->fenetre, 0, sizeof(chronos->fenetre));
+    chronos->presentees = 0;
+    chronos->debutFenetre = maintenant;
+    return true;
+}
+
+bool chronoEcrireCsv(const Chronos *chronos, const char *chemin)
+{
+    FILE *fichier = fopen(chemin, "w");
+    if (fichier == NULL)
+    {
+        fprintf(stderr, "Impossible d'écrire les mesures dans %s.\n", chemin);
+        return false;
+    }
+    fprintf(fichier, "etape,images,moyenne_ns,p50_ns,p90_ns,p99_ns,max_ns\n");
+    for (int e = 0; e < NB_ETAPES; e++)
+    {
+        const Histogramme *h = &chronos->etapes[e];
+        fprintf(fichier, "%s,%llu,%.0f,%llu,%llu,%llu,%llu\n", nomsEtapes[e], (unsigned long long)h->nombre,
+                h->nombre ? (double)h->totalNs / h->nombre : 0.0,
+                (unsigned long long)histogrammePercentile(h, 0.50), (unsigned long long)histogrammePercentile(h, 0.90),
+                (unsigned long long)histogrammePercentile(h, 0.99), (unsigned long long)h->maxNs);
+    }
+    bool ok = fclose(fichier) == 0;
+    if (!ok)
+    {
+        fprintf(stderr, "Erreur d'écriture de %s.\n", chemin);
+    }
+    return ok;
+}
@@ -0,0 +1,81 @@
+#ifndef CHRONO_H
+#define CHRONO_H
+
+// Temps passé par image dans chaque étape de la boucle de jeu, sans dépendance à SDL.
+// Chaque étape a son histogramme (8 cases par puissance de 2 : au plus 12,5 % d'erreur),
+// rempli une fois par image avec le total de l'étape dans cette image.
+// Les chiffres affichés en jeu (p50, p99, images/s) portent sur la dernière seconde écoulée.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CHRONO_SOUS_CASES 8
+#define CHRONO_CASES (62 * CHRONO_SOUS_CASES)
+#define CHRONO_FENETRE_NS 1000000000ULL
+
+typedef enum
+{
+    ETAPE_EVENEMENTS,   // lecture et traitement des événements, hors règles : le reste de l'image
+    ETAPE_REGLES,       // tirs et objets du joueur, tours du dealer
+    ETAPE_RECHARGE,     // genererBalles et distribution des objets quand le fusil est vide
+    ETAPE_DESSIN,       // drawGrid et superposition
+    ETAPE_PRESENTATION, // SDL_RenderPresent
+    ETAPE_IMAGE,        // toute l'image
+    NB_ETAPES
+} Etape;
+
+typedef struct
+{
+    uint32_t cases[CHRONO_CASES];
+    uint64_t nombre;
+    uint64_t totalNs;
+    uint64_t maxNs;
+} Histogramme;
+
+typedef struct
+{
+    Histogramme etapes[NB_ETAPES]; // depuis le lancement
+    uint64_t enCours[NB_ETAPES];   // cumul de l'image en cours
+    uint32_t vues;                 // étapes passées dans l'image en cours (un bit par étape)
+    uint64_t debutImage;           // 0 : pas d'image en cours
+
+    Histogramme fenetre; // durées des images de la fenêtre en cours
+    uint64_t debutFenetre;
+    int presentees;
+
+    // Chiffres de la dernière fenêtre terminée
+    double p50Ms;
+    double p99Ms;
+    double imagesParSeconde;
+} Chronos;
+
+void chronoInit(Chronos *chronos);
+
+// Horloge monotone en nanosecondes
+uint64_t chronoMaintenant(void);
+
+// Début d'une mesure : ne lit pas l'horloge si chronos est NULL (mesures désactivées)
+static inline uint64_t chronoDebut(const Chronos *chronos)
+{
+    return chronos != NULL ? chronoMaintenant() : 0;
+}
+
+// Ajoute le temps écoulé depuis debut à l'étape, pour l'image en cours
+void chronoFin(Chronos *chronos, Etape etape, uint64_t debut);
+
+void chronoDebutImage(Chronos *chronos);
+
+// Range les cumuls de l'image en cours dans les histogrammes ; sans effet si aucune image n'est en cours
+void chronoFinImage(Chronos *chronos);
+
+// Termine la fenêtre si elle a duré CHRONO_FENETRE_NS ; retourne true si les chiffres affichés ont changé
+bool chronoFenetreTerminee(Chronos *chronos);
+
+// Durée (ns) sous laquelle se trouve la fraction demandée des échantillons (0,5 : médiane)
+uint64_t histogrammePercentile(const Histogramme *histogramme, double fraction);
+
+// Une ligne par étape : nombre d'images, moyenne, p50, p90, p99, max
+bool chronoEcrireCsv(const Chronos *chronos, const char *chemin);
+
+#endif
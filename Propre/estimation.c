@@ -0,0 +1,214 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "estimation.h"
+#include "ia.h"
+#include "politique.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PARTIES_PAR_LOT 256 // par action, entre deux mises en commun
+
+static uint64_t maintenantNs(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+// Redistribue les balles restantes dans un ordre aléatoire, en gardant les comptes ;
+// la balle courante reste en place si la loupe du joueur l'a révélée
+static void melangerBalles(Partie *partie, Alea *alea)
+{
+    int premiere = partie->balleVue ? 1 : 0;
+    uint8_t balles = partie->balleVue ? partie->balles & 1 : 0;
+    int rouges = nombreRouges(partie) - balles;
+    int restantes = partie->nombreDeBalles - premiere;
+    for (int i = premiere; i < partie->nombreDeBalles; i++, restantes--)
+    {
+        if (aleaBorne(alea, restantes) < rouges)
+        {
+            balles |= (uint8_t)(1u << i);
+            rouges--;
+        }
+    }
+    partie->balles = balles;
+}
+
+// Le joueur tire sur cible, puis la partie va à son terme : le dealer joue ses tours comme
+// dans le jeu (jouerTour), le joueur avec jouerObjets et politiqueHeuristique
+static bool jouerPartie(const Partie *depart, Cible cible, Politique politiqueOrdi, Alea *alea)
+{
+    Partie partie = *depart;
+    melangerBalles(&partie, alea);
+    tirer(&partie, cible);
+    rechargerSiVide(&partie, alea);
+    return finirMatchTours(&partie, politiqueHeuristique, politiqueOrdi, alea);
+}
+
+// Vrai s'il reste du travail pour l'état courant ; à appeler verrou pris
+static bool aEstimer(const Estimateur *estimateur)
+{
+    return estimateur->active && maintenantNs() < estimateur->finNs &&
+           (estimateur->parties[CIBLE_ADVERSAIRE] < ESTIMATION_MAX_PARTIES ||
+            estimateur->parties[CIBLE_SOI] < ESTIMATION_MAX_PARTIES);
+}
+
+static void *travailler(void *argument)
+{
+    TravailleurEstimation *travailleur = argument;
+    Estimateur *estimateur = travailleur->estimateur;
+
+    pthread_mutex_lock(&estimateur->verrou);
+    for (;;)
+    {
+        while (!estimateur->arret && !aEstimer(estimateur))
+        {
+            pthread_cond_wait(&estimateur->travail, &estimateur->verrou);
+        }
+        if (estimateur->arret)
+        {
+            break;
+        }
+        Partie partie = estimateur->partie;
+        uint64_t generation = estimateur->generation;
+        pthread_mutex_unlock(&estimateur->verrou);
+
+        // Un lot pour chaque action, hors verrou
+        uint64_t victoires[2] = {0, 0};
+        for (int i = 0; i < PARTIES_PAR_LOT; i++)
+        {
+            victoires[CIBLE_ADVERSAIRE] += jouerPartie(&partie, CIBLE_ADVERSAIRE, estimateur->politiqueOrdi, &travailleur->alea);
+            victoires[CIBLE_SOI] += jouerPartie(&partie, CIBLE_SOI, estimateur->politiqueOrdi, &travailleur->alea);
+        }
+
+        pthread_mutex_lock(&estimateur->verrou);
+        // L'état a pu changer pendant le lot : ses résultats ne valent alors plus rien
+        if (estimateur->generation == generation)
+        {
+            for (int c = 0; c < 2; c++)
+            {
+                estimateur->victoires[c] += victoires[c];
+                estimateur->parties[c] += PARTIES_PAR_LOT;
+            }
+        }
+    }
+    pthread_mutex_unlock(&estimateur->verrou);
+    // États absents de la table partagée, si le dealer est l'expectimax
+    libererIaThread();
+    return NULL;
+}
+
+bool estimationDemarrer(Estimateur *estimateur, int nbThreads, uint64_t graine, Politique politiqueOrdi)
+{
+    memset(estimateur, 0, sizeof(*estimateur));
+    estimateur->politiqueOrdi = politiqueOrdi;
+    if (nbThreads <= 0)
+    {
+        nbThreads = (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    }
+    if (nbThreads < 1)
+    {
+        nbThreads = 1;
+    }
+    if (nbThreads > ESTIMATION_MAX_THREADS)
+    {
+        nbThreads = ESTIMATION_MAX_THREADS;
+    }
+
+    pthread_mutex_init(&estimateur->verrou, NULL);
+    pthread_cond_init(&estimateur->travail, NULL);
+
+    // Une seule graine, découpée en flux disjoints comme dans le simulateur
+    Alea flux;
+    aleaInit(&flux, graine);
+    for (int t = 0; t < nbThreads; t++)
+    {
+        estimateur->travailleurs[t].estimateur = estimateur;
+        estimateur->travailleurs[t].alea = flux;
+        aleaSaut(&flux);
+        if (pthread_create(&estimateur->threads[t], NULL, travailler, &estimateur->travailleurs[t]) != 0)
+        {
+            fprintf(stderr, "Impossible de créer le thread d'estimation %d.\n", t);
+            break;
+        }
+        estimateur->nbThreads++;
+    }
+    if (estimateur->nbThreads == 0)
+    {
+        pthread_cond_destroy(&estimateur->travail);
+        pthread_mutex_destroy(&estimateur->verrou);
+        return false;
+    }
+    return true;
+}
+
+void estimationDemander(Estimateur *estimateur, const Partie *partie)
+{
+    if (estimateur->nbThreads == 0)
+    {
+        return;
+    }
+    pthread_mutex_lock(&estimateur->verrou);
+    estimateur->generation++;
+    estimateur->partie = *partie;
+    estimateur->active = partie->joueurTurn && partie->nombreDeBalles > 0 && !mancheTerminee(partie) &&
+                         (estimateur->politiqueOrdi != politiqueExpectimax || iaPrete());
+    estimateur->finNs = maintenantNs() + ESTIMATION_BUDGET_NS;
+    memset(estimateur->victoires, 0, sizeof(estimateur->victoires));
+    memset(estimateur->parties, 0, sizeof(estimateur->parties));
+    pthread_cond_broadcast(&estimateur->travail);
+    pthread_mutex_unlock(&estimateur->verrou);
+}
+
+void estimationAnnuler(Estimateur *estimateur)
+{
+    if (estimateur->nbThreads == 0)
+    {
+        return;
+    }
+    pthread_mutex_lock(&estimateur->verrou);
+    estimateur->generation++;
+    estimateur->active = false;
+    pthread_mutex_unlock(&estimateur->verrou);
+}
+
+void estimationLire(Estimateur *estimateur, Estimation *estimation)
+{
+    memset(estimation, 0, sizeof(*estimation));
+    if (estimateur->nbThreads == 0)
+    {
+        return;
+    }
+    pthread_mutex_lock(&estimateur->verrou);
+    for (int c = 0; c < 2; c++)
+    {
+        estimation->parties[c] = estimateur->parties[c];
+        estimation->victoire[c] = estimateur->parties[c] ? (double)estimateur->victoires[c] / estimateur->parties[c] : 0.0;
+    }
+    estimation->valide = estimateur->active && estimation->parties[CIBLE_ADVERSAIRE] > 0;
+    estimation->enCours = aEstimer(estimateur);
+    pthread_mutex_unlock(&estimateur->verrou);
+}
+
+void estimationArreter(Estimateur *estimateur)
+{
+    if (estimateur->nbThreads == 0)
+    {
+        return;
+    }
+    pthread_mutex_lock(&estimateur->verrou);
+    estimateur->arret = true;
+    pthread_cond_broadcast(&estimateur->travail);
+    pthread_mutex_unlock(&estimateur->verrou);
+
+    for (int t = 0; t < estimateur->nbThreads; t++)
+    {
+        pthread_join(estimateur->threads[t], NULL);
+    }
+    pthread_cond_destroy(&estimateur->travail);
+    pthread_mutex_destroy(&estimateur->verrou);
+    estimateur->nbThreads = 0;
+}
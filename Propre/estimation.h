@@ -0,0 +1,75 @@
+#ifndef ESTIMATION_H
+#define ESTIMATION_H
+
+// Probabilité de victoire du joueur (match complet) selon qu'il tire sur le dealer ou sur
+// lui-même, estimée par des parties aléatoires jouées sur un groupe de threads de fond.
+// L'estimation s'affine tant que le budget de temps n'est pas épuisé ; l'appelant lit le
+// dernier résultat quand il veut, sans jamais attendre.
+// Seul ce que montre le HUD est connu : les comptes de balles, et la balle courante si la
+// loupe du joueur l'a révélée ; le reste du chargeur est tiré à nouveau pour chaque partie.
+// Le dealer joue ensuite comme celui du jeu (jouerTour), avec la politique passée à
+// estimationDemarrer ; le joueur joue ses objets (jouerObjets) et politiqueHeuristique.
+// Avec politiqueExpectimax, rien n'est estimé avant que prechaufferIa ait publié sa table :
+// les threads ne font ensuite qu'y lire, sans résoudre chacun leur propre copie.
+
+#include "regles.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ESTIMATION_MAX_THREADS 8
+#define ESTIMATION_BUDGET_NS 1500000000ULL
+#define ESTIMATION_MAX_PARTIES 200000 // par action : au-delà, l'erreur est déjà sous 0,25 point
+
+typedef struct
+{
+    double victoire[2];   // indexé par Cible
+    uint64_t parties[2];  // parties jouées pour chaque cible
+    bool enCours;         // le budget n'est pas épuisé, le résultat va encore changer
+    bool valide;          // une estimation existe pour l'état demandé
+} Estimation;
+
+typedef struct Estimateur Estimateur;
+
+typedef struct
+{
+    Estimateur *estimateur;
+    Alea alea; // flux propre au thread
+} TravailleurEstimation;
+
+struct Estimateur
+{
+    pthread_mutex_t verrou;
+    pthread_cond_t travail;
+    pthread_t threads[ESTIMATION_MAX_THREADS];
+    TravailleurEstimation travailleurs[ESTIMATION_MAX_THREADS];
+    int nbThreads;
+    bool arret;
+    Politique politiqueOrdi; // dealer joué dans les parties aléatoires
+
+    // État demandé, et résultats accumulés pour lui seulement
+    Partie partie;
+    uint64_t generation;
+    uint64_t finNs;
+    bool active;
+    uint64_t victoires[2];
+    uint64_t parties[2];
+};
+
+// nbThreads <= 0 : un thread par coeur, moins celui de l'affichage.
+// politiqueOrdi : le dealer que le joueur affronte réellement
+bool estimationDemarrer(Estimateur *estimateur, int nbThreads, uint64_t graine, Politique politiqueOrdi);
+
+// Abandonne l'estimation en cours et commence celle de partie (ignorée si ce n'est pas au joueur,
+// ou si la table de l'expectimax n'est pas encore prête : redemander une fois iaPrete())
+void estimationDemander(Estimateur *estimateur, const Partie *partie);
+
+// Plus rien à estimer (fin de partie, tour du dealer)
+void estimationAnnuler(Estimateur *estimateur);
+
+void estimationLire(Estimateur *estimateur, Estimation *estimation);
+
+void estimationArreter(Estimateur *estimateur);
+
+#endif
@@ -0,0 +1,217 @@
+#include "grid.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "assets.h"
+#include "jeu.h"
+#include "trace.h"
+
+void renderCachedText(SDL_Renderer *renderer, TextCache *cache, const char *text, int x, int y, TTF_Font *font, SDL_Color color)
+{
+    if (cache->texture == NULL || strcmp(cache->text, text) != 0)
+    {
+        if (cache->texture != NULL)
+        {
+            SDL_DestroyTexture(cache->texture);
+            cache->texture = NULL;
+        }
+
+        // UTF-8 : les prénoms saisis dans la fenêtre peuvent porter des accents
+        SDL_Surface *surface = TTF_RenderUTF8_Solid(font, text, color);
+        if (surface == NULL)
+        {
+            TRACE_ERREUR(TRACE_RENDU, "Unable to render text surface! SDL_ttf Error: %s", TTF_GetError());
+            return;
+        }
+        cache->texture = SDL_CreateTextureFromSurface(renderer, surface);
+        cache->rect.w = surface->w;
+        cache->rect.h = surface->h;
+        SDL_FreeSurface(surface);
+        snprintf(cache->text, sizeof(cache->text), "%s", text);
+    }
+
+    cache->rect.x = x;
+    cache->rect.y = y;
+    SDL_RenderCopy(renderer, cache->texture, NULL, &cache->rect);
+}
+
+void freeTextCache(TextCache *caches, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (caches[i].texture != NULL)
+        {
+            SDL_DestroyTexture(caches[i].texture);
+        }
+        caches[i].texture = NULL;
+        caches[i].text[0] = '\0';
+    }
+}
+
+void drawGrid(SDL_Renderer *renderer, GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2], TTF_Font *font, TextCache hud[HUD_LINES], const Partie *partie, const SDL_Rect *pompeRect)
+{
+    // Draw main grid
+    // Set background color to black
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer); // Clear screen with black color
+
+    // Draw main grid
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // Couleur blanche pour les bordures
+    for (int i = 0; i < GRID_ROWS; i++)
+    {
+        for (int j = 0; j < GRID_COLS; j++)
+        {
+            SDL_RenderDrawRect(renderer, &grid[i][j].rect);
+        }
+    }
+
+    // Draw subgrids
+    for (int g = 0; g < 4; g++)
+    {
+        for (int i = 0; i < SUBGRID_ROWS; i++)
+        {
+            for (int j = 0; j < SUBGRID_COLS; j++)
+            {
+                SDL_RenderDrawRect(renderer, &subgrids[g][i][j].rect);
+            }
+        }
+    }
+
+    // Draw extra cells
+    for (int i = 0; i < 2; i++)
+    {
+        SDL_RenderDrawRect(renderer, &extraCells[i].rect);
+    }
+
+    // Toutes les copies depuis l'atlas à la suite, après les bordures, pour qu'elles forment un seul lot
+    for (int g = 0; g < 4; g++)
+    {
+        for (int i = 0; i < SUBGRID_ROWS; i++)
+        {
+            for (int j = 0; j < SUBGRID_COLS; j++)
+            {
+                Object objet = objetEn(partie, subgrids[g][i][j].id - PREMIERE_CASE_OBJET);
+                if (objet != Null)
+                {
+                    assetDrawObject(renderer, objet, &subgrids[g][i][j].rect);
+                }
+            }
+        }
+    }
+    assetDraw(renderer, TEXTURE_POMPE, pompeRect);
+
+    SDL_Color color = {255, 255, 255, 255}; // white
+    char buffer[128];
+
+    // Information about red and black balls
+    snprintf(buffer, sizeof(buffer), "%d RED", nombreRouges(partie));
+    renderCachedText(renderer, &hud[0], buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 10, font, color);
+    snprintf(buffer, sizeof(buffer), "%d BLANK", nombreNoirs(partie));
+    renderCachedText(renderer, &hud[1], buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 30, font, color);
+    snprintf(buffer, sizeof(buffer), "Total: %d", partie->nombreDeBalles);
+    renderCachedText(renderer, &hud[2], buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 50, font, color);
+    // Balle courante montrée par la loupe du joueur, jusqu'à ce qu'elle quitte le chargeur
+    if (partie->balleVue)
+    {
+        renderCachedText(renderer, &hud[6], balleEn(partie, 0) == ROUGE ? "Next: RED" : "Next: BLANK",
+                         extraCells[0].rect.x + 10, extraCells[0].rect.y + 70, font, color);
+    }
+
+    // Information about the game state
+    snprintf(buffer, sizeof(buffer), "Round %d", partie->manche);
+    renderCachedText(renderer, &hud[3], buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 10, font, color);
+    snprintf(buffer, sizeof(buffer), "You: %d", partie->vieJoueur);
+    renderCachedText(renderer, &hud[4], buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 30, font, color);
+    snprintf(buffer, sizeof(buffer), "Dealer: %d", partie->vieOrdi);
+    renderCachedText(renderer, &hud[5], buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 50, font, color);
+}
+
+void drawFrameStats(SDL_Renderer *renderer, GridCell extraCells[2], TTF_Font *font, TextCache stats[STATS_LINES], const Chronos *chronos)
+{
+    SDL_Color color = {255, 220, 0, 255};
+    char buffer[32];
+    int x = extraCells[1].rect.x + 10;
+    int y = extraCells[1].rect.y + extraCells[1].rect.h - 70;
+
+    snprintf(buffer, sizeof(buffer), "p50 %.2fms", chronos->p50Ms);
+    renderCachedText(renderer, &stats[0], buffer, x, y, font, color);
+    snprintf(buffer, sizeof(buffer), "p99 %.2fms", chronos->p99Ms);
+    renderCachedText(renderer, &stats[1], buffer, x, y + 20, font, color);
+    snprintf(buffer, sizeof(buffer), "%.0f FPS", chronos->imagesParSeconde);
+    renderCachedText(renderer, &stats[2], buffer, x, y + 40, font, color);
+}
+
+void drawWinOdds(SDL_Renderer *renderer, GridCell extraCells[2], TTF_Font *font, TextCache odds[ODDS_LINES], const Estimation *estimation)
+{
+    if (!estimation->valide)
+    {
+        return;
+    }
+    SDL_Color color = {255, 255, 255, 255};
+    char buffer[32];
+    int x = extraCells[0].rect.x + 10;
+    int y = extraCells[0].rect.y + 100;
+
+    renderCachedText(renderer, &odds[0], "Win odds", x, y, font, color);
+    snprintf(buffer, sizeof(buffer), "D %.1f%%", 100.0 * estimation->victoire[CIBLE_ADVERSAIRE]);
+    renderCachedText(renderer, &odds[1], buffer, x, y + 20, font, color);
+    snprintf(buffer, sizeof(buffer), "Me %.1f%%", 100.0 * estimation->victoire[CIBLE_SOI]);
+    renderCachedText(renderer, &odds[2], buffer, x, y + 40, font, color);
+}
+
+void buildGameLayout(GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2], SDL_Rect *imageRect, HitMap *hits)
+{
+    imageRect->x = CELL_WIDTH + CELL_WIDTH / 2 - CELL_WIDTH / 4;
+    imageRect->y = CELL_HEIGHT / 2;
+    imageRect->w = CELL_WIDTH / 2;
+    imageRect->h = CELL_HEIGHT;
+
+    int idCounter = 0;
+    for (int i = 0; i < GRID_ROWS; ++i) {
+        for (int j = 0; j < GRID_COLS; ++j) {
+            grid[i][j].rect = (SDL_Rect){j * CELL_WIDTH, i * CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT};
+            grid[i][j].id = idCounter++;
+        }
+    }
+
+    SDL_Rect subgrid_positions[4] = {
+        {0, 0, CELL_WIDTH, CELL_HEIGHT},
+        {CELL_WIDTH * 2, 0, CELL_WIDTH, CELL_HEIGHT},
+        {0, CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT},
+        {CELL_WIDTH * 2, CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT}};
+
+    for (int g = 0; g < 4; ++g) {
+        for (int i = 0; i < SUBGRID_ROWS; ++i) {
+            for (int j = 0; j < SUBGRID_COLS; ++j) {
+                subgrids[g][i][j].rect = (SDL_Rect){
+                    subgrid_positions[g].x + SUBGRID_MARGIN + j * (SUBGRID_CELL_WIDTH + SUBGRID_MARGIN),
+                    subgrid_positions[g].y + SUBGRID_MARGIN + i * (SUBGRID_CELL_HEIGHT + SUBGRID_MARGIN),
+                    SUBGRID_CELL_WIDTH,
+                    SUBGRID_CELL_HEIGHT};
+                subgrids[g][i][j].id = idCounter++;
+            }
+        }
+    }
+
+    extraCells[0] = (GridCell){{SCREEN_WIDTH - 100, 0, 100, SCREEN_HEIGHT / 2}, idCounter++};
+    extraCells[1] = (GridCell){{SCREEN_WIDTH - 100, SCREEN_HEIGHT / 2, 100, SCREEN_HEIGHT / 2}, idCounter++};
+
+    // Table des clics : les cases d'objet d'abord, puisqu'elles sont posées sur les cases principales
+    hitmapInit(hits);
+    for (int g = 0; g < 4; ++g) {
+        for (int i = 0; i < SUBGRID_ROWS; ++i) {
+            for (int j = 0; j < SUBGRID_COLS; ++j) {
+                hitmapAdd(hits, subgrids[g][i][j].id, subgrids[g][i][j].rect);
+            }
+        }
+    }
+    for (int i = 0; i < GRID_ROWS; ++i) {
+        for (int j = 0; j < GRID_COLS; ++j) {
+            hitmapAdd(hits, grid[i][j].id, grid[i][j].rect);
+        }
+    }
+    for (int i = 0; i < 2; ++i) {
+        hitmapAdd(hits, extraCells[i].id, extraCells[i].rect);
+    }
+}
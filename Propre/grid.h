@@ -0,0 +1,71 @@
+#ifndef GRID_H
+#define GRID_H
+
+// Grille de jeu : position des cases, dessin de la partie et correspondance clic -> id de case.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+
+#include "chrono.h"
+#include "estimation.h"
+#include "hitmap.h"
+#include "regles.h"
+
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 600
+
+#define GRID_ROWS 2
+#define GRID_COLS 3
+#define CELL_WIDTH ((SCREEN_WIDTH - 100) / GRID_COLS)
+#define CELL_HEIGHT (SCREEN_HEIGHT / GRID_ROWS)
+
+#define SUBGRID_ROWS 2
+#define SUBGRID_COLS 2
+#define SUBGRID_MARGIN 5
+#define SUBGRID_CELL_WIDTH ((CELL_WIDTH - (SUBGRID_COLS + 1) * SUBGRID_MARGIN) / SUBGRID_COLS)
+#define SUBGRID_CELL_HEIGHT ((CELL_HEIGHT - (SUBGRID_ROWS + 1) * SUBGRID_MARGIN) / SUBGRID_ROWS)
+
+// Lignes du HUD (balles, balle révélée par la loupe et état de la partie) dans les cases supplémentaires
+#define HUD_LINES 7
+// Lignes de la superposition des temps d'image (F3), sous le HUD
+#define STATS_LINES 3
+// Lignes des chances de victoire estimées, sous les balles
+#define ODDS_LINES 3
+#define TEXT_CACHE_MAX 64
+
+_Static_assert(HITMAP_WIDTH >= SCREEN_WIDTH && HITMAP_HEIGHT >= SCREEN_HEIGHT, "la table des clics couvre toute la fenêtre");
+
+typedef struct
+{
+    SDL_Rect rect;
+    int id;
+} GridCell;
+
+// Texture d'un texte, recréée seulement quand la chaîne change
+typedef struct
+{
+    char text[TEXT_CACHE_MAX];
+    SDL_Texture *texture;
+    SDL_Rect rect;
+} TextCache;
+
+void renderCachedText(SDL_Renderer *renderer, TextCache *cache, const char *text, int x, int y, TTF_Font *font, SDL_Color color);
+void freeTextCache(TextCache *caches, int count);
+
+// Place les cases de la grille de jeu et l'image du fusil, et compile la table des clics
+void buildGameLayout(GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2], SDL_Rect *imageRect, HitMap *hits);
+void drawGrid(SDL_Renderer *renderer, GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2], TTF_Font *font, TextCache hud[HUD_LINES], const Partie *partie, const SDL_Rect *pompeRect);
+// Temps d'image de la dernière fenêtre de mesure, dans la partie libre des cases supplémentaires
+void drawFrameStats(SDL_Renderer *renderer, GridCell extraCells[2], TTF_Font *font, TextCache stats[STATS_LINES], const Chronos *chronos);
+
+// Chances de victoire du joueur s'il tire sur le dealer (case 1) ou sur lui-même (case 4)
+void drawWinOdds(SDL_Renderer *renderer, GridCell extraCells[2], TTF_Font *font, TextCache odds[ODDS_LINES], const Estimation *estimation);
+
+// Id de la case cliquée, ou -1
+static inline int handleMouseClick(const HitMap *hits, int x, int y)
+{
+    return hitmapFind(hits, x, y);
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "hitmap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void hitmapInit(HitMap *hits)
+{
+    memset(hits->rects, 0, sizeof(hits->rects));
+    memset(hits->tiles, -1, sizeof(hits->tiles));
+}
+
+bool hitmapAdd(HitMap *hits, int id, SDL_Rect rect)
+{
+    if (id < 0 || id >= HITMAP_MAX_IDS || rect.w <= 0 || rect.h <= 0)
+    {
+        return false;
+    }
+    hits->rects[id] = rect;
+
+    // Carreaux recouverts par le rectangle, bornés à la fenêtre
+    int col0 = rect.x < 0 ? 0 : rect.x / HITMAP_TILE;
+    int row0 = rect.y < 0 ? 0 : rect.y / HITMAP_TILE;
+    int col1 = (rect.x + rect.w - 1) / HITMAP_TILE;
+    int row1 = (rect.y + rect.h - 1) / HITMAP_TILE;
+    if (col1 >= HITMAP_COLS)
+    {
+        col1 = HITMAP_COLS - 1;
+    }
+    if (row1 >= HITMAP_ROWS)
+    {
+        row1 = HITMAP_ROWS - 1;
+    }
+
+    bool ok = true;
+    for (int row = row0; row <= row1; row++)
+    {
+        for (int col = col0; col <= col1; col++)
+        {
+            int8_t *candidates = hits->tiles[row][col];
+            int i = 0;
+            while (i < HITMAP_CANDIDATES && candidates[i] >= 0)
+            {
+                i++;
+            }
+            if (i == HITMAP_CANDIDATES)
+            {
+                ok = false;
+                continue;
+            }
+            // Les zones ajoutées en premier sont testées en premier : elles gagnent si deux zones se recouvrent
+            candidates[i] = (int8_t)id;
+        }
+    }
+
+    if (!ok)
+    {
+        fprintf(stderr, "Trop de zones cliquables se recouvrent autour de la zone %d\n", id);
+    }
+    return ok;
+}
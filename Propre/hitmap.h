@@ -0,0 +1,52 @@
+#ifndef HITMAP_H
+#define HITMAP_H
+
+// Table de correspondance pixel -> id de zone cliquable, construite une fois par écran.
+// La fenêtre est découpée en carreaux de HITMAP_TILE pixels ; chaque carreau garde les ids
+// des quelques zones qui le recouvrent. Un clic coûte une lecture du carreau et au plus
+// HITMAP_CANDIDATES tests de rectangle, quel que soit le nombre de zones.
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Taille de la fenêtre couverte par la table
+#define HITMAP_WIDTH 800
+#define HITMAP_HEIGHT 600
+
+#define HITMAP_TILE 20
+#define HITMAP_COLS ((HITMAP_WIDTH + HITMAP_TILE - 1) / HITMAP_TILE)
+#define HITMAP_ROWS ((HITMAP_HEIGHT + HITMAP_TILE - 1) / HITMAP_TILE)
+// Au croisement des marges d'une sous-grille, un carreau touche 4 cases et la case parente
+#define HITMAP_CANDIDATES 6
+#define HITMAP_MAX_IDS 32
+
+typedef struct
+{
+    SDL_Rect rects[HITMAP_MAX_IDS]; // rectangle de chaque id
+    int8_t tiles[HITMAP_ROWS][HITMAP_COLS][HITMAP_CANDIDATES]; // ids qui recouvrent le carreau, -1 si libre
+} HitMap;
+
+void hitmapInit(HitMap *hits);
+bool hitmapAdd(HitMap *hits, int id, SDL_Rect rect);
+
+// Id de la zone qui contient (x, y), ou -1
+static inline int hitmapFind(const HitMap *hits, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= HITMAP_WIDTH || y >= HITMAP_HEIGHT)
+    {
+        return -1;
+    }
+    const int8_t *candidates = hits->tiles[y / HITMAP_TILE][x / HITMAP_TILE];
+    SDL_Point point = {x, y};
+    for (int i = 0; i < HITMAP_CANDIDATES && candidates[i] >= 0; i++)
+    {
+        if (SDL_PointInRect(&point, &hits->rects[candidates[i]]))
+        {
+            return candidates[i];
+        }
+    }
+    return -1;
+}
+
+#endif
@@ -0,0 +1,543 @@
+#include "ia.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bornes du modèle (les valeurs au-delà sont écrêtées dans la clé)
+#define VIE_MAX 31
+#define OBJETS_MAX 1
+// Vies en début de manche : 3 à 6 tirées par debuterManche, plus une par cigarette
+// gardée (au plus une par emplacement), puisque les cigarettes sont comptées dans les vies
+#define VIE_DEPART_MIN 3
+#define VIE_DEPART_MAX (6 + EMPLACEMENTS_PAR_CAMP)
+#define EGALITE 1e-12 // écart de valeurs en deçà duquel deux actions se valent
+
+#define CAMP_ORDI 0
+#define CAMP_JOUEUR 1
+
+// État vu par le solveur : seuls les comptes de balles sont connus, pas leur ordre.
+// Une cigarette ne fait que rendre une vie : l'utiliser tout de suite est toujours
+// optimal, elle est donc directement comptée dans les vies. Pour les autres objets,
+// seule la présence compte (OBJETS_MAX), ce qui borne la taille de l'espace d'états.
+// Le renouvellement des objets lors d'une recharge n'est pas modélisé : les
+// inventaires ne font que diminuer, ce qui garantit que la recherche termine.
+typedef struct
+{
+    int rouges;
+    int noirs;
+    int vieJoueur;
+    int vieOrdi;
+    bool joueurTurn;
+    int connue; // couleur de la balle courante si une loupe l'a révélée, sinon BALLE_INCONNUE
+    int objets[2][NB_OBJETS];
+} EtatIa;
+
+typedef struct
+{
+    uint64_t cle;
+    double valeur;
+} Entree;
+
+typedef struct
+{
+    Entree *entrees;
+    size_t capacite;
+    size_t occupation;
+} TableIa;
+
+// Table remplie une fois par prechaufferIa puis lue sans verrou par tous les threads ;
+// chaque thread range les états qu'elle ne contient pas dans sa propre table
+static TableIa partagee;
+static atomic_bool partageePubliee = false;
+static _Thread_local TableIa locale;
+
+// probabiliteChargeur[n][r] : probabilité qu'une recharge donne n balles dont r rouges
+static _Thread_local double probabiliteChargeur[MAX_BALLES + 1][MAX_BALLES + 1];
+static _Thread_local bool chargeurCalcule = false;
+
+static double valeur(const EtatIa *etat);
+
+static uint64_t cleEtat(const EtatIa *etat)
+{
+    uint64_t cle = (uint64_t)etat->rouges
+                 | (uint64_t)etat->noirs << 4
+                 | (uint64_t)etat->vieJoueur << 8
+                 | (uint64_t)etat->vieOrdi << 13
+                 | (uint64_t)etat->joueurTurn << 18
+                 | (uint64_t)etat->connue << 19;
+    for (int camp = 0; camp < 2; camp++)
+    {
+        for (int o = 0; o < NB_OBJETS; o++)
+        {
+            cle |= (uint64_t)etat->objets[camp][o] << (21 + 4 * (camp * NB_OBJETS + o));
+        }
+    }
+    // Bit de poids fort toujours à 1 : une clé nulle marque une case vide
+    return cle | (1ULL << 63);
+}
+
+static size_t indexCle(const TableIa *table, uint64_t cle)
+{
+    return (size_t)((cle * 0x9E3779B97F4A7C15ULL) >> 20) & (table->capacite - 1);
+}
+
+static bool chercherDans(const TableIa *table, uint64_t cle, double *valeur)
+{
+    if (table->entrees == NULL)
+    {
+        return false;
+    }
+    for (size_t i = indexCle(table, cle);; i = (i + 1) & (table->capacite - 1))
+    {
+        if (table->entrees[i].cle == cle)
+        {
+            *valeur = table->entrees[i].valeur;
+            return true;
+        }
+        if (table->entrees[i].cle == 0)
+        {
+            return false;
+        }
+    }
+}
+
+static bool chercher(uint64_t cle, double *valeur)
+{
+    if (atomic_load_explicit(&partageePubliee, memory_order_acquire) && chercherDans(&partagee, cle, valeur))
+    {
+        return true;
+    }
+    return chercherDans(&locale, cle, valeur);
+}
+
+static void agrandirTable(TableIa *table)
+{
+    TableIa ancienne = *table;
+
+    table->capacite = ancienne.capacite ? ancienne.capacite * 2 : 1 << 16;
+    table->entrees = calloc(table->capacite, sizeof(Entree));
+    if (table->entrees == NULL)
+    {
+        // Plus de mémoire : on repart de l'ancienne table, les états seront recalculés
+        *table = ancienne;
+        return;
+    }
+
+    for (size_t j = 0; j < ancienne.capacite; j++)
+    {
+        if (ancienne.entrees[j].cle != 0)
+        {
+            size_t i = indexCle(table, ancienne.entrees[j].cle);
+            while (table->entrees[i].cle != 0)
+            {
+                i = (i + 1) & (table->capacite - 1);
+            }
+            table->entrees[i] = ancienne.entrees[j];
+        }
+    }
+    free(ancienne.entrees);
+}
+
+static void inserer(uint64_t cle, double valeur)
+{
+    TableIa *table = &locale;
+    if (2 * (table->occupation + 1) > table->capacite)
+    {
+        agrandirTable(table);
+        if (2 * (table->occupation + 1) > table->capacite)
+        {
+            return;
+        }
+    }
+    size_t i = indexCle(table, cle);
+    while (table->entrees[i].cle != 0 && table->entrees[i].cle != cle)
+    {
+        i = (i + 1) & (table->capacite - 1);
+    }
+    if (table->entrees[i].cle == 0)
+    {
+        table->occupation++;
+    }
+    table->entrees[i].cle = cle;
+    table->entrees[i].valeur = valeur;
+}
+
+static void viderTable(TableIa *table)
+{
+    free(table->entrees);
+    memset(table, 0, sizeof(*table));
+}
+
+static void calculerProbabilitesChargeur(void)
+{
+    // genererBalles : n uniforme dans [2, 8], chaque balle rouge avec probabilité 1/2,
+    // puis la dernière balle est forcée si toutes sont de la même couleur
+    for (int n = 2; n <= MAX_BALLES; n++)
+    {
+        double coefficient = 1.0;
+        for (int r = 0; r <= n; r++)
+        {
+            double p = coefficient / (double)(1u << n) / (MAX_BALLES - 1);
+            int rouges = r == 0 ? 1 : (r == n ? n - 1 : r);
+            probabiliteChargeur[n][rouges] += p;
+            coefficient = coefficient * (n - r) / (r + 1);
+        }
+    }
+    chargeurCalcule = true;
+}
+
+static int ecreter(int valeur, int max)
+{
+    return valeur > max ? max : valeur;
+}
+
+static double probabiliteRouge(const EtatIa *etat)
+{
+    if (etat->connue != BALLE_INCONNUE)
+    {
+        return etat->connue == ROUGE ? 1.0 : 0.0;
+    }
+    return (double)etat->rouges / (etat->rouges + etat->noirs);
+}
+
+static int *vieDuCamp(EtatIa *etat, bool joueur)
+{
+    return joueur ? &etat->vieJoueur : &etat->vieOrdi;
+}
+
+static double valeurTir(const EtatIa *etat, Cible cible)
+{
+    double pRouge = probabiliteRouge(etat);
+    double resultat = 0.0;
+
+    if (pRouge > 0.0)
+    {
+        EtatIa suivant = *etat;
+        suivant.rouges--;
+        suivant.connue = BALLE_INCONNUE;
+        (*vieDuCamp(&suivant, (cible == CIBLE_SOI) == etat->joueurTurn))--;
+        suivant.joueurTurn = !etat->joueurTurn;
+        resultat += pRouge * valeur(&suivant);
+    }
+    if (pRouge < 1.0)
+    {
+        EtatIa suivant = *etat;
+        suivant.noirs--;
+        suivant.connue = BALLE_INCONNUE;
+        if (cible == CIBLE_ADVERSAIRE)
+        {
+            suivant.joueurTurn = !etat->joueurTurn;
+        }
+        resultat += (1.0 - pRouge) * valeur(&suivant);
+    }
+    return resultat;
+}
+
+// Partie concrète de l'état, la balle courante de la couleur donnée et les autres dans
+// un ordre quelconque : les effets d'objets de regles.c s'y appliquent tels quels
+static void partieDepuisEtat(const EtatIa *etat, int couleur, Partie *partie)
+{
+    int rouges = etat->rouges - (couleur == ROUGE);
+    memset(partie, 0, sizeof(*partie));
+    partie->objets = OBJETS_VIDES;
+    partie->balles = (uint8_t)((((1u << rouges) - 1) << 1) | (couleur == ROUGE));
+    partie->nombreDeBalles = (uint8_t)(etat->rouges + etat->noirs);
+    partie->vieJoueur = (int8_t)etat->vieJoueur;
+    partie->vieOrdi = (int8_t)etat->vieOrdi;
+    partie->joueurTurn = etat->joueurTurn;
+}
+
+// Valeur d'un objet utilisé par le camp dont c'est le tour (l'objet est déjà retiré) :
+// moyenne sur la couleur de la balle courante et sur les issues de son effet
+static double valeurObjet(const EtatIa *etat, Object objet)
+{
+    const EffetObjet *effet = &effetsObjets[objet];
+    double pRouge = probabiliteRouge(etat);
+    double resultat = 0.0;
+
+    for (int couleur = ROUGE; couleur <= NOIR; couleur++)
+    {
+        double p = couleur == ROUGE ? pRouge : 1.0 - pRouge;
+        if (p == 0.0)
+        {
+            continue;
+        }
+        for (int issue = 0; issue < effet->issues; issue++)
+        {
+            Partie partie;
+            partieDepuisEtat(etat, couleur, &partie);
+            effet->appliquer(&partie, etat->joueurTurn ? &partie.vieJoueur : &partie.vieOrdi, issue);
+
+            EtatIa suivant = *etat;
+            suivant.rouges = nombreRouges(&partie);
+            suivant.noirs = nombreNoirs(&partie);
+            suivant.vieJoueur = ecreter(partie.vieJoueur, VIE_MAX);
+            suivant.vieOrdi = ecreter(partie.vieOrdi, VIE_MAX);
+            if (effet->revele)
+            {
+                suivant.connue = couleur;
+            }
+            else if (partie.nombreDeBalles != etat->rouges + etat->noirs)
+            {
+                suivant.connue = BALLE_INCONNUE;
+            }
+            resultat += p / effet->issues * valeur(&suivant);
+        }
+    }
+    return resultat;
+}
+
+// Objet inutile : une loupe quand la balle courante est déjà connue
+static bool objetUtile(const EtatIa *etat, int camp, int objet)
+{
+    return etat->objets[camp][objet] > 0 && !(effetsObjets[objet].revele && etat->connue != BALLE_INCONNUE);
+}
+
+static double valeurDecision(const EtatIa *etat)
+{
+    int camp = etat->joueurTurn ? CAMP_JOUEUR : CAMP_ORDI;
+
+    // L'ordinateur maximise sa probabilité de victoire, le joueur la minimise
+    double meilleur = valeurTir(etat, CIBLE_ADVERSAIRE);
+    double v = valeurTir(etat, CIBLE_SOI);
+    meilleur = etat->joueurTurn ? (v < meilleur ? v : meilleur) : (v > meilleur ? v : meilleur);
+
+    for (int o = 0; o < NB_OBJETS; o++)
+    {
+        if (!objetUtile(etat, camp, o))
+        {
+            continue;
+        }
+        EtatIa suivant = *etat;
+        suivant.objets[camp][o]--;
+        v = valeurObjet(&suivant, (Object)o);
+        meilleur = etat->joueurTurn ? (v < meilleur ? v : meilleur) : (v > meilleur ? v : meilleur);
+    }
+    return meilleur;
+}
+
+static double valeurRecharge(const EtatIa *etat)
+{
+    double resultat = 0.0;
+    for (int n = 2; n <= MAX_BALLES; n++)
+    {
+        for (int r = 1; r < n; r++)
+        {
+            EtatIa suivant = *etat;
+            suivant.rouges = r;
+            suivant.noirs = n - r;
+            suivant.connue = BALLE_INCONNUE;
+            resultat += probabiliteChargeur[n][r] * valeur(&suivant);
+        }
+    }
+    return resultat;
+}
+
+static double valeur(const EtatIa *etat)
+{
+    if (etat->vieJoueur <= 0)
+    {
+        return 1.0;
+    }
+    if (etat->vieOrdi <= 0)
+    {
+        return 0.0;
+    }
+
+    uint64_t cle = cleEtat(etat);
+    double resultat;
+    if (chercher(cle, &resultat))
+    {
+        return resultat;
+    }
+
+    resultat = etat->rouges + etat->noirs == 0 ? valeurRecharge(etat) : valeurDecision(etat);
+    inserer(cle, resultat);
+    return resultat;
+}
+
+static void etatDepuisPartie(const Partie *partie, EtatIa *etat)
+{
+    memset(etat, 0, sizeof(*etat));
+    etat->rouges = nombreRouges(partie);
+    etat->noirs = nombreNoirs(partie);
+    etat->vieJoueur = partie->vieJoueur;
+    etat->vieOrdi = partie->vieOrdi;
+    etat->joueurTurn = partie->joueurTurn;
+    etat->connue = BALLE_INCONNUE;
+
+    for (int i = 0; i < NB_EMPLACEMENTS; i++)
+    {
+        Object objet = objetEn(partie, i);
+        bool joueur = i >= PREMIER_EMPLACEMENT_JOUEUR;
+        if (objet == CIGARETTE)
+        {
+            (*vieDuCamp(etat, joueur))++;
+        }
+        else if (objet != Null)
+        {
+            int camp = joueur ? CAMP_JOUEUR : CAMP_ORDI;
+            etat->objets[camp][objet] = ecreter(etat->objets[camp][objet] + 1, OBJETS_MAX);
+        }
+    }
+    etat->vieJoueur = ecreter(etat->vieJoueur, VIE_MAX);
+    etat->vieOrdi = ecreter(etat->vieOrdi, VIE_MAX);
+
+    if (!chargeurCalcule)
+    {
+        calculerProbabilitesChargeur();
+    }
+}
+
+double probabiliteVictoireOrdi(const Partie *partie)
+{
+    EtatIa etat;
+    etatDepuisPartie(partie, &etat);
+    return valeur(&etat);
+}
+
+// Meilleur tir du camp au trait, *valeur étant sa valeur vue par ce camp (plus grande
+// est meilleure) ; à valeur égale, le générateur de la partie départage s'il y en a un
+static Cible meilleurTir(const EtatIa *etat, Alea *alea, double *valeur)
+{
+    double signe = etat->joueurTurn ? -1.0 : 1.0;
+    double adversaire = signe * valeurTir(etat, CIBLE_ADVERSAIRE);
+    double soi = signe * valeurTir(etat, CIBLE_SOI);
+
+    double ecart = soi - adversaire;
+    if (ecart >= -EGALITE && ecart <= EGALITE)
+    {
+        *valeur = adversaire;
+        return alea != NULL && aleaBorne(alea, 2) == 0 ? CIBLE_SOI : CIBLE_ADVERSAIRE;
+    }
+    *valeur = ecart > 0 ? soi : adversaire;
+    return ecart > 0 ? CIBLE_SOI : CIBLE_ADVERSAIRE;
+}
+
+Cible politiqueExpectimax(const Partie *partie, Alea *alea)
+{
+    EtatIa etat;
+    etatDepuisPartie(partie, &etat);
+
+    if (etat.rouges + etat.noirs == 0)
+    {
+        return CIBLE_ADVERSAIRE;
+    }
+    double valeurTir;
+    return meilleurTir(&etat, alea, &valeurTir);
+}
+
+int decisionIa(const Partie *partie, int connue, Alea *alea)
+{
+    // Les cigarettes d'abord : le modèle les compte déjà dans les vies
+    int premier = partie->joueurTurn ? PREMIER_EMPLACEMENT_JOUEUR : 0;
+    for (int i = premier; i < premier + EMPLACEMENTS_PAR_CAMP; i++)
+    {
+        if (objetEn(partie, i) == CIGARETTE)
+        {
+            return DECISION_OBJET + CIGARETTE;
+        }
+    }
+
+    EtatIa etat;
+    etatDepuisPartie(partie, &etat);
+    etat.connue = connue;
+    if (etat.rouges + etat.noirs == 0)
+    {
+        return DECISION_TIR_ADVERSAIRE;
+    }
+
+    double meilleur;
+    int decision = meilleurTir(&etat, alea, &meilleur);
+
+    // Un objet seulement s'il vaut strictement mieux que le tir
+    int camp = etat.joueurTurn ? CAMP_JOUEUR : CAMP_ORDI;
+    double signe = etat.joueurTurn ? -1.0 : 1.0;
+    for (int o = 0; o < NB_OBJETS; o++)
+    {
+        if (!objetUtile(&etat, camp, o))
+        {
+            continue;
+        }
+        EtatIa suivant = etat;
+        suivant.objets[camp][o]--;
+        double v = signe * valeurObjet(&suivant, (Object)o);
+        if (v > meilleur + EGALITE)
+        {
+            meilleur = v;
+            decision = DECISION_OBJET + o;
+        }
+    }
+    return decision;
+}
+
+bool jouerObjetsExpectimax(Partie *partie, Alea *alea, Cible *cible)
+{
+    return jouerObjetsDecides(partie, decisionIa, alea, cible);
+}
+
+void prechaufferIa(void)
+{
+    if (iaPrete())
+    {
+        return;
+    }
+
+    Partie partie;
+    memset(&partie, 0, sizeof(partie));
+    partie.objets = OBJETS_VIDES;
+    partie.joueurTurn = true;
+
+    // Un exemplaire de chaque objet de chaque côté, sauf la cigarette déjà comptée dans
+    // les vies : tous les inventaires plus petits sont atteints pendant la recherche
+    for (int o = 0; o < NB_OBJETS; o++)
+    {
+        if (o != CIGARETTE)
+        {
+            placerObjet(&partie, o, (Object)o);
+            placerObjet(&partie, PREMIER_EMPLACEMENT_JOUEUR + o, (Object)o);
+        }
+    }
+
+    // Les deux camps n'ont pas forcément autant de cigarettes : toutes les paires de vies
+    for (int vieJoueur = VIE_DEPART_MIN; vieJoueur <= VIE_DEPART_MAX; vieJoueur++)
+    {
+        for (int vieOrdi = VIE_DEPART_MIN; vieOrdi <= VIE_DEPART_MAX; vieOrdi++)
+        {
+            partie.vieJoueur = (int8_t)vieJoueur;
+            partie.vieOrdi = (int8_t)vieOrdi;
+            probabiliteVictoireOrdi(&partie);
+        }
+    }
+
+    // La table du thread devient la table partagée : plus aucune écriture après la publication
+    partagee = locale;
+    memset(&locale, 0, sizeof(locale));
+    atomic_store_explicit(&partageePubliee, true, memory_order_release);
+}
+
+bool iaPrete(void)
+{
+    return atomic_load_explicit(&partageePubliee, memory_order_acquire);
+}
+
+size_t tailleTableIa(void)
+{
+    return (iaPrete() ? partagee.occupation : 0) + locale.occupation;
+}
+
+void libererIaThread(void)
+{
+    viderTable(&locale);
+}
+
+void libererIa(void)
+{
+    viderTable(&locale);
+    if (iaPrete())
+    {
+        viderTable(&partagee);
+        atomic_store_explicit(&partageePubliee, false, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef IA_H
+#define IA_H
+
+// Dealer optimal : expectimax exact sur (rouges, noirs, vies, tireur, inventaires),
+// mémoïsé dans des tables de transposition. prechaufferIa remplit une fois la table
+// partagée, ensuite lue sans verrou par tous les threads ; chaque thread range les états
+// qui n'y sont pas dans sa propre table.
+
+#include "regles.h"
+
+#include <stddef.h>
+
+// Probabilité que l'ordinateur gagne la manche en cours, les deux camps jouant au mieux
+double probabiliteVictoireOrdi(const Partie *partie);
+
+// Politique expectimax : meilleure cible pour le camp dont c'est le tour
+Cible politiqueExpectimax(const Partie *partie, Alea *alea);
+
+// Décision (Decision) du camp au trait, objets compris : une cigarette dès qu'il en a une,
+// sinon le meilleur tir, ou un objet s'il vaut strictement mieux. Sans générateur,
+// l'égalité entre les deux tirs donne un tir sur l'adversaire.
+int decisionIa(const Partie *partie, int connue, Alea *alea);
+
+// Tour complet du camp au trait, objets choisis par decisionIa : même contrat que jouerObjetsDecides
+bool jouerObjetsExpectimax(Partie *partie, Alea *alea, Cible *cible);
+
+// Résout à l'avance les débuts de manche (toutes les vies de départ, tous les inventaires)
+// et publie la table pour tous les threads. À n'appeler que d'un seul thread ; ne fait rien
+// si la table est déjà publiée. Avant la publication, chaque thread résout à la demande.
+void prechaufferIa(void);
+
+// Vrai une fois la table de prechaufferIa publiée
+bool iaPrete(void);
+
+// Nombre d'états résolus : table partagée et table du thread appelant
+size_t tailleTableIa(void);
+
+// Libère la table du thread appelant, avant qu'il se termine
+void libererIaThread(void);
+
+// Libère aussi la table partagée : en fin de programme, une fois les autres threads terminés
+void libererIa(void);
+
+#endif
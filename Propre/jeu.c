@@ -0,0 +1,227 @@
+#include "jeu.h"
+#include "politique.h"
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Récit de la partie : une trace d'information, seulement pour une partie bavarde
+#define RACONTER(jeu, categorie, ...)               \
+    do                                              \
+    {                                               \
+        if ((jeu)->bavard)                          \
+        {                                           \
+            TRACE_INFO(categorie, __VA_ARGS__);     \
+        }                                           \
+    } while (0)
+
+typedef enum
+{
+    ACTION_AUCUNE,
+    ACTION_TIR,   // parametre : Cible
+    ACTION_OBJET  // parametre : emplacement
+} TypeAction;
+
+typedef struct
+{
+    uint8_t type;
+    uint8_t parametre;
+} ActionCase;
+
+#define CASE_OBJET_JOUEUR(emplacement) [PREMIERE_CASE_OBJET + (emplacement)] = {ACTION_OBJET, (emplacement)}
+
+// Action de chaque case cliquable pour le joueur : un clic se résout en une lecture
+static const ActionCase actionsCases[NB_CASES] = {
+    [CASE_TIR_ADVERSAIRE] = {ACTION_TIR, CIBLE_ADVERSAIRE},
+    [CASE_TIR_SOI] = {ACTION_TIR, CIBLE_SOI},
+    CASE_OBJET_JOUEUR(8),
+    CASE_OBJET_JOUEUR(9),
+    CASE_OBJET_JOUEUR(10),
+    CASE_OBJET_JOUEUR(11),
+    CASE_OBJET_JOUEUR(12),
+    CASE_OBJET_JOUEUR(13),
+    CASE_OBJET_JOUEUR(14),
+    CASE_OBJET_JOUEUR(15),
+};
+
+_Static_assert(PREMIER_EMPLACEMENT_JOUEUR == 8 && NB_EMPLACEMENTS == 16, "la table des cases suit les emplacements du joueur");
+
+// Dévoile le chargeur : trace de débogage, une seule ligne pour tout le chargeur
+static void afficherBalles(const Jeu *jeu, const char *titre)
+{
+    if (!TRACE_ACTIVE(TRACE_NIVEAU_DEBUG) || !jeu->bavard)
+    {
+        return;
+    }
+    char balles[MAX_BALLES * 6 + 1] = "";
+    int longueur = 0;
+    for (int i = 0; i < jeu->partie.nombreDeBalles; i++)
+    {
+        longueur += snprintf(balles + longueur, sizeof(balles) - longueur, " %s", balleEn(&jeu->partie, i) == ROUGE ? "Rouge" : "Noir");
+    }
+    TRACE_DEBUG(TRACE_REGLES, "%s%s", titre, balles);
+}
+
+static void afficherObjets(const Jeu *jeu)
+{
+    if (!TRACE_ACTIVE(TRACE_NIVEAU_DEBUG) || !jeu->bavard)
+    {
+        return;
+    }
+    for (int i = 0; i < NB_EMPLACEMENTS; i++)
+    {
+        Object objet = objetEn(&jeu->partie, i);
+        if (objet != Null)
+        {
+            TRACE_DEBUG(TRACE_REGLES, "%s a %s dans la case %d", i < PREMIER_EMPLACEMENT_JOUEUR ? "L'ordinateur" : "Le joueur",
+                        effetsObjets[objet].nom, i + PREMIERE_CASE_OBJET);
+        }
+    }
+}
+
+static void afficherManche(const Jeu *jeu)
+{
+    RACONTER(jeu, TRACE_REGLES, "Manche %d: Vie Joueur = %d, Vie Ordi = %d", jeu->partie.manche, jeu->partie.vieJoueur, jeu->partie.vieOrdi);
+    afficherBalles(jeu, "Balles générées :");
+    afficherObjets(jeu);
+}
+
+static void joueurTour(Jeu *jeu, Cible cible)
+{
+    Partie *partie = &jeu->partie;
+    int balle = tirer(partie, cible);
+    RACONTER(jeu, TRACE_REGLES, "Le joueur a tiré sur %s et la balle était %s",
+             cible == CIBLE_ADVERSAIRE ? "l'ordinateur" : "lui-même", balle == ROUGE ? "rouge" : "noire");
+    afficherBalles(jeu, "Balles restantes après le tour du joueur :");
+}
+
+// Raconte les objets qu'un camp vient d'utiliser : ceux qui ont quitté ses emplacements
+static void raconterObjetsUtilises(const Jeu *jeu, const char *qui, const Partie *avant, int balle)
+{
+    for (int i = 0; i < NB_EMPLACEMENTS; i++)
+    {
+        Object objet = objetEn(avant, i);
+        if (objet == Null || objetEn(&jeu->partie, i) != Null)
+        {
+            continue;
+        }
+        if (effetsObjets[objet].revele)
+        {
+            RACONTER(jeu, TRACE_REGLES, "%s a utilisé %s : la balle courante est %s", qui, effetsObjets[objet].nom, balle == ROUGE ? "rouge" : "noire");
+        }
+        else
+        {
+            RACONTER(jeu, TRACE_REGLES, "%s a utilisé %s (vies %d/%d)", qui, effetsObjets[objet].nom, jeu->partie.vieJoueur, jeu->partie.vieOrdi);
+        }
+    }
+}
+
+static void ordinateurTour(Jeu *jeu)
+{
+    Partie *partie = &jeu->partie;
+
+    Partie avant = *partie;
+    Cible cible;
+    // Objets puis tir, comme dans les simulations ; une bière peut vider le chargeur, des pillules finir la manche
+    bool tir = jouerTour(partie, jeu->politiqueOrdi, &jeu->alea, &cible);
+    raconterObjetsUtilises(jeu, "L'ordinateur", &avant, balleEn(partie, 0));
+    if (!tir)
+    {
+        return;
+    }
+    int balle = tirer(partie, cible);
+    RACONTER(jeu, TRACE_IA, "L'ordinateur a tiré sur %s et la balle était %s.",
+             cible == CIBLE_ADVERSAIRE ? "le joueur" : "lui-même", balle == ROUGE ? "rouge" : "noire");
+    afficherBalles(jeu, "Balles restantes après le tour de l'ordinateur :");
+}
+
+static void utiliserObjetJoueur(Jeu *jeu, int emplacement)
+{
+    Partie avant = jeu->partie;
+    utiliserObjet(&jeu->partie, emplacement, &jeu->alea);
+    raconterObjetsUtilises(jeu, "Le joueur", &avant, balleEn(&avant, 0));
+}
+
+// Recharge le fusil et distribue de nouveaux objets quand il est vide
+static void recharger(Jeu *jeu)
+{
+    if (jeu->partie.nombreDeBalles == 0)
+    {
+        uint64_t debut = chronoDebut(jeu->chronos);
+        rechargerSiVide(&jeu->partie, &jeu->alea);
+        chronoFin(jeu->chronos, ETAPE_RECHARGE, debut);
+        afficherBalles(jeu, "Balles générées :");
+        afficherObjets(jeu);
+    }
+}
+
+void jeuDemarrer(Jeu *jeu, uint64_t graine, Politique politiqueOrdi, bool bavard)
+{
+    jeu->graine = graine;
+    jeu->politiqueOrdi = politiqueOrdi;
+    jeu->bavard = bavard;
+    jeu->chronos = NULL;
+    jeu->etat = JEU_EN_COURS;
+    aleaInit(&jeu->alea, graine);
+    nouvellePartie(&jeu->partie, &jeu->alea);
+    afficherManche(jeu);
+}
+
+bool jeuCliquer(Jeu *jeu, int idCase)
+{
+    Partie *partie = &jeu->partie;
+    if (jeu->etat != JEU_EN_COURS || !partie->joueurTurn)
+    {
+        return false;
+    }
+
+    ActionCase action = idCase >= 0 && idCase < NB_CASES ? actionsCases[idCase] : (ActionCase){ACTION_AUCUNE, 0};
+    if (action.type == ACTION_AUCUNE)
+    {
+        return false;
+    }
+
+    Partie avant = *partie;
+    uint64_t debut = chronoDebut(jeu->chronos);
+    if (action.type == ACTION_TIR)
+    {
+        joueurTour(jeu, (Cible)action.parametre);
+    }
+    else
+    {
+        utiliserObjetJoueur(jeu, action.parametre);
+    }
+    chronoFin(jeu->chronos, ETAPE_REGLES, debut);
+    recharger(jeu);
+
+    // Le dealer joue tous ses tirs d'affilée : le clic suivant ne peut concerner que le joueur
+    while (!partie->joueurTurn && !mancheTerminee(partie))
+    {
+        debut = chronoDebut(jeu->chronos);
+        ordinateurTour(jeu);
+        chronoFin(jeu->chronos, ETAPE_REGLES, debut);
+        recharger(jeu);
+    }
+
+    if (mancheTerminee(partie))
+    {
+        if (partie->vieJoueur <= 0)
+        {
+            RACONTER(jeu, TRACE_REGLES, "Vous avez perdu face au Dealer %d.", partie->manche);
+            jeu->etat = JEU_PERDU;
+        }
+        else if (partie->manche < NB_MANCHES)
+        {
+            partie->manche++;
+            debuterManche(partie, &jeu->alea);
+            afficherManche(jeu);
+        }
+        else
+        {
+            RACONTER(jeu, TRACE_REGLES, "Vous avez gagné les %d manches !", NB_MANCHES);
+            jeu->etat = JEU_GAGNE;
+        }
+    }
+
+    return memcmp(&avant, partie, sizeof(avant)) != 0 || jeu->etat != JEU_EN_COURS;
+}
@@ -0,0 +1,44 @@
+#ifndef JEU_H
+#define JEU_H
+
+// Déroulement d'une partie à partir des clics du joueur, sans dépendance à SDL :
+// la fenêtre et la relecture des replays passent exactement par le même code.
+// Toute la partie est déterminée par la graine et la suite des cases cliquées.
+
+#include "chrono.h"
+#include "regles.h"
+
+// Ids des cases de la grille de jeu
+#define CASE_TIR_ADVERSAIRE 1
+#define CASE_TIR_SOI 4
+#define PREMIERE_CASE_OBJET 6 // emplacement 0, les emplacements suivent dans l'ordre des ids
+#define PREMIERE_CASE_OBJET_JOUEUR (PREMIERE_CASE_OBJET + PREMIER_EMPLACEMENT_JOUEUR)
+#define DERNIERE_CASE_OBJET_JOUEUR (PREMIERE_CASE_OBJET + NB_EMPLACEMENTS - 1)
+#define NB_CASES (PREMIERE_CASE_OBJET + NB_EMPLACEMENTS + 2) // + les deux cases d'informations
+
+typedef enum
+{
+    JEU_EN_COURS,
+    JEU_GAGNE,
+    JEU_PERDU
+} EtatJeu;
+
+typedef struct
+{
+    Partie partie;
+    Alea alea;
+    Politique politiqueOrdi;
+    uint64_t graine;
+    EtatJeu etat;
+    bool bavard; // raconte la partie dans la console
+    Chronos *chronos; // temps des règles et des recharges, NULL par défaut
+} Jeu;
+
+void jeuDemarrer(Jeu *jeu, uint64_t graine, Politique politiqueOrdi, bool bavard);
+
+// Applique un clic sur la case idCase, puis fait jouer le dealer jusqu'à ce que la main
+// revienne au joueur, et passe à la manche suivante si celle-ci est terminée.
+// Retourne true si l'état de la partie a changé.
+bool jeuCliquer(Jeu *jeu, int idCase);
+
+#endif
@@ -1,603 +1,179 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
 
+#include "assets.h"
+#include "chrono.h"
+#include "estimation.h"
+#include "grid.h"
+#include "hitmap.h"
+#include "ia.h"
+#include "jeu.h"
+#include "politique.h"
+#include "regles.h"
+#include "replay.h"
+#include "scoreboard.h"
+#include "scores.h"
+#include "textfield.h"
+#include "trace.h"
+
 // Constants for window and button dimensions
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 600;
 const int BUTTON_WIDTH = 200;
 const int BUTTON_HEIGHT = 50;
 
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
-
-const int GRID_ROWS = 2;
-const int GRID_COLS = 3;
-const int CELL_WIDTH = (SCREEN_WIDTH - 100) / GRID_COLS;
-const int CELL_HEIGHT = SCREEN_HEIGHT / GRID_ROWS;
-
-const int SUBGRID_ROWS = 2;
-const int SUBGRID_COLS = 2;
-const int SUBGRID_MARGIN = 5;
-const int SUBGRID_CELL_WIDTH = (CELL_WIDTH - (SUBGRID_COLS + 1) * SUBGRID_MARGIN) / SUBGRID_COLS;
-const int SUBGRID_CELL_HEIGHT = (CELL_HEIGHT - (SUBGRID_ROWS + 1) * SUBGRID_MARGIN) / SUBGRID_ROWS;
+// Attente maximale d'un événement dans la boucle principale (ms)
+#define EVENT_WAIT_TIMEOUT_MS 500
 
-SDL_Texture *imageTexture = NULL;
-SDL_Rect imageRect;
-
-#define ROUGE 0
-#define NOIR 1
+// Pause entre deux clics quand un replay est rejoué à l'écran (ms)
+#define REPLAY_RENDER_DELAY_MS 400
+// Rafraîchissement des chances de victoire tant que l'estimation s'affine
+#define ODDS_REFRESH_MS 100
+// Lecture du compteur du journal partagé tant que le scoreboard est affiché
+#define SCORES_POLL_MS 100
 
 // Function prototypes
 bool initializeSDL();
-bool loadMedia();
 void closeSDL();
 void renderTitle();
 void renderButtons();
-bool renderGame(); 
-
-typedef enum
-{
-    CIGARETTE,
-    BIERRE,
-    LOUPE,
-    PILLULES,
-    Null
-} Object;
-
-typedef struct
-{
-    SDL_Rect rect;
-    bool clicked;
-    int id;
-    Object object;
-    SDL_Texture *texture;
-} GridCell;
 
 typedef enum 
 {
     STATE_MENU,
+    STATE_NAME_ENTRY,
     STATE_GAME,
     STATE_SCOREBOARD,
     STATE_QUIT
 } GameState;
 
+// Ids des boutons dans les tables de clic du menu et du scoreboard
+typedef enum
+{
+    BUTTON_LAUNCH,
+    BUTTON_SCOREBOARD,
+    BUTTON_QUIT,
+    BUTTON_RETURN,
+    BUTTON_COUNT
+} ButtonId;
+
+// État atteint par un clic sur chaque bouton
+static const GameState buttonTargets[BUTTON_COUNT] = {
+    [BUTTON_LAUNCH] = STATE_NAME_ENTRY,
+    [BUTTON_SCOREBOARD] = STATE_SCOREBOARD,
+    [BUTTON_QUIT] = STATE_QUIT,
+    [BUTTON_RETURN] = STATE_MENU,
+};
+
 // Global variables
 SDL_Window *gWindow = NULL;
 SDL_Renderer *gRenderer = NULL;
-SDL_Texture *gLaunchButtonTexture = NULL;
-SDL_Texture *gScoreboardButtonTexture = NULL;
-SDL_Texture *gQuitButtonTexture = NULL;
-SDL_Texture *gTitleTexture = NULL; 
-SDL_Texture *gReturnTexture = NULL;
+Scoreboard gScoreboard;
+ScoreStore gScores;
+bool gScoresOpen = false;
 SDL_Rect gLaunchButtonRect = {100, 100, 200, 50};
 SDL_Rect gScoreboardButtonRect = {100, 200, 200, 50};
 SDL_Rect gQuitButtonRect = {100, 300, 200, 50};
 SDL_Rect gTitleRect = {100, 50, 600, 100};
-SDL_Rect gReturnRect = {300, 500, 200, 50};
+SDL_Rect gReturnButtonRect = {50, 500, 100, 50};
+SDL_Rect gNameFieldRect = {250, 300, 300, 40};
+SDL_Rect gScoreListRect = {50, 50, 700, 420}; // au-dessus du bouton retour
+HitMap gMenuHits;
+HitMap gScoreboardHits;
 GameState currentState = STATE_MENU;
-bool quit = false;
-
-SDL_Texture *loadTexture(SDL_Renderer *renderer, const char *path)
-{
-    SDL_Surface *loadedSurface = IMG_Load(path);
-    if (loadedSurface == NULL)
-    {
-        printf("Unable to load image %s! SDL_image Error: %s\n", path, IMG_GetError());
-        return NULL;
-    }
-
-    SDL_Texture *newTexture = SDL_CreateTextureFromSurface(renderer, loadedSurface);
-    SDL_FreeSurface(loadedSurface);
-
-    if (newTexture == NULL)
-    {
-        printf("Unable to create texture from %s! SDL Error: %s\n", path, SDL_GetError());
-    }
-
-    return newTexture;
-}
-
-void renderText(SDL_Renderer *renderer, const char *text, int x, int y, TTF_Font *font, SDL_Color color)
-{
-    SDL_Surface *surface = TTF_RenderText_Solid(font, text, color);
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect destRect = {x, y, surface->w, surface->h};
-    SDL_FreeSurface(surface);
-    SDL_RenderCopy(renderer, texture, NULL, &destRect);
-    SDL_DestroyTexture(texture);
+bool gNeedsRedraw = true; // l'écran de l'état courant a changé depuis le dernier affichage
+int gWaitMs = EVENT_WAIT_TIMEOUT_MS; // attente maximale du prochain événement, choisie par l'état courant
+Politique gPolitiqueOrdi = politiqueTable; // choisie par l'option --dealer
+bool gGraineFixee = false; // --seed : toutes les parties rejouent la même donne
+uint64_t gGraine = 0;
+const char *gReplayDir = NULL; // --record : dossier où chaque partie écrit son replay
+Chronos gChronos; // temps de chaque étape des images de jeu, sur toute la session
+bool gShowFrameStats = false; // F3 : superposition des temps d'image
+const char *gFrameStatsPath = NULL; // --frame-stats : CSV des temps par étape écrit en quittant
+Estimateur gEstimateur; // chances de victoire du joueur, calculées en fond pendant qu'il réfléchit
+bool gStartupTimes = false; // --startup-times : délais de démarrage affichés une fois connus
+uint64_t gProcessStart = 0; // horloge de chronoMaintenant au lancement du processus
+uint64_t gFirstFrameNs = 0; // lancement -> première image du menu présentée
+uint64_t gGameReadyNs = 0; // lancement -> images du jeu envoyées au renderer
+pthread_t gWarmThread; // préchauffage de l'expectimax, lancé avant SDL_Init comme le décodage des images
+bool gWarmStarted = false;
+Uint32 gAiReadyEvent = (Uint32)-1; // réveille la boucle quand la table de l'expectimax est publiée
+
+int generateRandomAmount(Alea *alea) {
+    return aleaBorne(alea, 701) + 500; // Génère un nombre entre 500 et 1200
 }
 
-void drawGrid(SDL_Renderer *renderer, GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2], TTF_Font *font, int nbrRouge, int nbrNoir, int nbrBalles, int manche, int vieJoueur, int vieOrdi)
-{
-    // Draw main grid
-    // Set background color to black
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer); // Clear screen with black color
-
-    // Draw main grid
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // Couleur blanche pour les bordures
-    for (int i = 0; i < GRID_ROWS; i++)
-    {
-        for (int j = 0; j < GRID_COLS; j++)
-        {
-            SDL_RenderDrawRect(renderer, &grid[i][j].rect);
-        }
-    }
-
-    // Draw subgrids
-    for (int g = 0; g < 4; g++)
-    {
-        for (int i = 0; i < SUBGRID_ROWS; i++)
-        {
-            for (int j = 0; j < SUBGRID_COLS; j++)
-            {
-                SDL_RenderDrawRect(renderer, &subgrids[g][i][j].rect);
-                if (subgrids[g][i][j].texture != NULL)
-                {
-                    SDL_RenderCopy(renderer, subgrids[g][i][j].texture, NULL, &subgrids[g][i][j].rect);
-                }
-            }
-        }
+// Graine d'une nouvelle partie : l'horloge haute résolution distingue deux parties lancées dans la même seconde
+uint64_t nouvelleGraine() {
+    if (gGraineFixee) {
+        return gGraine;
     }
-
-    // Draw extra cells
-    for (int i = 0; i < 2; i++)
-    {
-        SDL_RenderDrawRect(renderer, &extraCells[i].rect);
-    }
-
-    SDL_Color color = {255, 255, 255, 255}; // white
-    char buffer[128];
-
-    // Information about red and black balls
-    snprintf(buffer, sizeof(buffer), "%d RED", nbrRouge);
-    renderText(renderer, buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 10, font, color);
-    snprintf(buffer, sizeof(buffer), "%d BLANK", nbrNoir);
-    renderText(renderer, buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 30, font, color);
-    snprintf(buffer, sizeof(buffer), "Total: %d", nbrBalles);
-    renderText(renderer, buffer, extraCells[0].rect.x + 10, extraCells[0].rect.y + 50, font, color);
-
-    // Information about the game state
-    snprintf(buffer, sizeof(buffer), "Round %d", manche);
-    renderText(renderer, buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 10, font, color);
-    snprintf(buffer, sizeof(buffer), "You: %d", vieJoueur);
-    renderText(renderer, buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 30, font, color);
-    snprintf(buffer, sizeof(buffer), "Dealer: %d", vieOrdi);
-    renderText(renderer, buffer, extraCells[1].rect.x + 10, extraCells[1].rect.y + 50, font, color);
+    return ((uint64_t)time(NULL) << 32) ^ SDL_GetPerformanceCounter();
 }
 
-void genererBalles(int *balles, int *rouge, int *noir, int *nombreDeBalles)
-{
-    srand(time(NULL));
-    *nombreDeBalles = (rand() % 7) + 2;
-    *rouge = 0;
-    *noir = 0;
-
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        balles[i] = rand() % 2;
-        if (balles[i] == ROUGE)
-        {
-            (*rouge)++;
-        }
-        else
-        {
-            (*noir)++;
-        }
-    }
+#define MAX_NAME_LENGTH 100
 
-    if (*rouge == 0)
-    {
-        balles[*nombreDeBalles - 1] = ROUGE;
-        (*rouge)++;
-        (*noir)--;
-    }
+// Structure pour stocker les informations du joueur
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+} Player;
 
-    if (*noir == 0)
-    {
-        balles[*nombreDeBalles - 1] = NOIR;
-        (*noir)++;
-        (*rouge)--;
-    }
+Player gPlayer;
+TextField gNameField; // saisie du prénom dans la fenêtre, entre le menu et la partie
 
-    printf("Balles générées:\n");
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-    }
+// Début de la saisie du prénom : le journal des scores n'en garde que SCORE_NOM_MAX - 1 octets
+bool beginNameEntry() {
+    textFieldBegin(&gNameField, gNameFieldRect, SCORE_NOM_MAX - 1);
+    return true;
 }
 
-int handleMouseClick(int x, int y, GridCell grid[GRID_ROWS][GRID_COLS], GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], GridCell extraCells[2])
-{
-    // Check subgrid cells first
-    for (int g = 0; g < 4; ++g)
-    {
-        for (int i = 0; i < SUBGRID_ROWS; ++i)
-        {
-            for (int j = 0; j < SUBGRID_COLS; ++j)
-            {
-                if (SDL_PointInRect(&(SDL_Point){x, y}, &subgrids[g][i][j].rect))
-                {
-                    subgrids[g][i][j].clicked = true;
-                    printf("Le joueur a cliqué sur la case %d dans la sous-grille %d\n", subgrids[g][i][j].id, g);
-                    return subgrids[g][i][j].id; // Return subgrid ID
-                }
-            }
-        }
-    }
-
-    // Check main grid cells
-    for (int i = 0; i < GRID_ROWS; ++i)
-    {
-        for (int j = 0; j < GRID_COLS; ++j)
-        {
-            if (SDL_PointInRect(&(SDL_Point){x, y}, &grid[i][j].rect))
-            {
-                grid[i][j].clicked = true;
-                printf("Le joueur a cliqué sur la case %d\n", grid[i][j].id);
-                return grid[i][j].id;
-            }
-        }
-    }
-
-    // Check extra cells
-    for (int i = 0; i < 2; ++i)
-    {
-        if (SDL_PointInRect(&(SDL_Point){x, y}, &extraCells[i].rect))
-        {
-            extraCells[i].clicked = true;
-            printf("Le joueur a cliqué sur la case supplémentaire %d\n", extraCells[i].id);
-            return extraCells[i].id;
-        }
-    }
-
-    return -1; // No click detected
+void endNameEntry() {
+    textFieldEnd(&gNameField);
 }
 
-bool joueurTour(int idCase, int *vieJoueur, int *vieOrdi, int *rouges, int *noirs, int *nombreDeBalles, int *balles)
-{
-    printf("Le joueur a cliqué sur la case avec l'ID: %d\n", idCase);
-    printf("La couleur de la balle est: %s\n", balles[0] == ROUGE ? "Rouge" : "Noir");
-    if (idCase == 1)
-    {
-        if (balles[0] == ROUGE)
-        {
-            printf("Le joueur a tiré sur l'ordinateur et la balle était rouge\n");
-            *vieOrdi -= 1;
-            *rouges -= 1;
-            *nombreDeBalles -= 1;
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                balles[i] = balles[i + 1];
-            }
-            balles[*nombreDeBalles] = -1;
-            printf("Balles restantes apres tour joueur:\n");
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-            }
-        }
-        else
-        {
-            printf("Le joueur a tiré sur l'ordinateur et la balle était noire\n");
-            *noirs -= 1;
-            *nombreDeBalles -= 1;
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                balles[i] = balles[i + 1];
-            }
-            balles[*nombreDeBalles] = -1;
-            printf("Balles restantes apres tour joueur:\n");
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-            }
-        }
+// Passe un événement au champ du prénom ; retourne l'état suivant
+GameState updateNameEntry(const SDL_Event *e) {
+    if (e == NULL) {
+        return STATE_NAME_ENTRY;
+    }
+    switch (textFieldHandleEvent(&gNameField, e)) {
+        case TEXT_FIELD_CHANGED:
+            gNeedsRedraw = true;
+            return STATE_NAME_ENTRY;
+        case TEXT_FIELD_SUBMITTED:
+            snprintf(gPlayer.name, sizeof(gPlayer.name), "%s", gNameField.text);
+            return STATE_GAME;
+        case TEXT_FIELD_CANCELLED:
+            return STATE_MENU;
+        default:
+            return STATE_NAME_ENTRY;
     }
-    else if (idCase == 4)
-    {
-        if (balles[0] == ROUGE)
-        {
-            printf("Le joueur a tiré sur lui-même et la balle était rouge\n");
-            *vieJoueur -= 1;
-            *rouges -= 1;
-            *nombreDeBalles -= 1;
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                balles[i] = balles[i + 1];
-            }
-            balles[*nombreDeBalles] = -1;
-            printf("Balles restantes apres tour joueur:\n");
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-            }
-        }
-        else
-        {
-            printf("Le joueur a tiré sur lui-même et la balle était noire\n");
-            *noirs -= 1;
-            *nombreDeBalles -= 1;
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                balles[i] = balles[i + 1];
-            }
-            balles[*nombreDeBalles] = -1;
-            printf("Balles restantes apres tour joueur:\n");
-            for (int i = 0; i < *nombreDeBalles; i++)
-            {
-                printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-            }
-            return true;
-        }
-    }
-
-    if (*vieJoueur <= 0)
-    {
-        printf("Le joueur a perdu!\n");
-        return true;
-    }
-    else if (*vieOrdi <= 0)
-    {
-        printf("Le joueur a gagné!\n");
-        return true;
-    }
-    return false;
 }
 
-bool ordinateurTour(int *vieJoueur, int *vieOrdi, int *rouges, int *noirs, int *nombreDeBalles, int *balles)
-{
-    if (*nombreDeBalles == 0)
-    {
-        printf("Il n'y a plus de balles.\n");
+// Ouvre le journal des scores ; l'instance qui le crée importe l'ancien scores.txt
+bool openScoreStore() {
+    if (!scoresOuvrir(&gScores, SCORES_JOURNAL, SCORES_INDEX, "scores.txt")) {
+        fprintf(stderr, "Erreur d'ouverture du fichier des scores.\n");
         return false;
     }
-
-    // L'ordinateur va essayer de maximiser son avantage
-    int cible = -1;
-    if (*rouges > *noirs && *rouges > 0) // Plus de balles rouges que de noires, attaquer joueur
-    {
-        cible = 1; // Tirer sur le joueur
-    }
-    else if (*noirs > *rouges && *noirs > 0) // Plus de balles noires que de rouges, tirer sur soi-même
-    {
-        cible = 2; // Tirer sur soi-même
-    }
-    else // Nombre égal de balles rouges et noires, ou une seule couleur restante
-    {
-        // Choisir au hasard, mais donner une légère préférence à tirer sur le joueur
-        srand(time(NULL));
-        cible = (rand() % 3 == 0) ? 2 : 1;
-    }
-
-    if (cible == 1)
-    {
-        printf("L'ordinateur a décidé de tirer sur le joueur.\n");
-        if (balles[0] == ROUGE)
-        {
-            printf("L'ordinateur a tiré sur le joueur et la balle était rouge.\n");
-            *vieJoueur -= 1;
-            *rouges -= 1;
-        }
-        else
-        {
-            printf("L'ordinateur a tiré sur le joueur et la balle était noire.\n");
-            *noirs -= 1;
-        }
-    }
-    else
-    {
-        printf("L'ordinateur a décidé de tirer sur lui-même.\n");
-        if (balles[0] == ROUGE)
-        {
-            printf("L'ordinateur a tiré sur lui-même et la balle était rouge.\n");
-            *vieOrdi -= 1;
-            *rouges -= 1;
-        }
-        else
-        {
-            printf("L'ordinateur a tiré sur lui-même et la balle était noire.\n");
-            *noirs -= 1;
-            *nombreDeBalles -= 1;
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        balles[i] = balles[i + 1];
-    }
-    balles[*nombreDeBalles] = -1;
-
-    printf("Balles restantes après le tour de l'ordinateur:\n");
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-    }
-            return true;
-        }
-    }
-
-    // Enlever la balle utilisée
-    *nombreDeBalles -= 1;
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        balles[i] = balles[i + 1];
-    }
-    balles[*nombreDeBalles] = -1;
-
-    printf("Balles restantes après le tour de l'ordinateur:\n");
-    for (int i = 0; i < *nombreDeBalles; i++)
-    {
-        printf("Balle %d: %s\n", i + 1, balles[i] == ROUGE ? "Rouge" : "Noir");
-    }
-
-    if (*vieJoueur <= 0)
-    {
-        printf("Le joueur a perdu!\n");
-        return true;
-    }
-    else if (*vieOrdi <= 0)
-    {
-        printf("L'ordinateur a perdu!\n");
-        return true;
-    }
-
-    return false;
-}
-
-void giveObject(GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS], SDL_Texture *textures[4])
-{
-    srand(time(NULL));
-    // Prend tout les index des cases 6 a 13 et ajoute les a une liste de case vide
-    int emptyCellPC[8][3] = {{0, 0, 0}, {0, 0, 1}, {0, 1, 0}, {0, 1, 1}, {1, 0, 0}, {1, 0, 1}, {1, 1, 0}, {1, 1, 1}};
-    int emptyCellJoueur[8][3] = {{2, 0, 0}, {2, 0, 1}, {2, 1, 0}, {2, 1, 1}, {3, 0, 0}, {3, 0, 1}, {3, 1, 0}, {3, 1, 1}};
-    int emptyCountPC = 8;
-    int emptyCountJoueur = 8;
-    // Choisir aléatoirement entre 1 et 4 le nombre d'objets
-    int nombreObjets = rand() % 4 + 1;
-    printf("L'ordinateur a trouvé %d objets\n", nombreObjets);
-    for (int i = 0; i < nombreObjets; i++)
-    {
-        if (emptyCountPC == 0)
-        {
-            printf("Il n'y a plus de cases vides disponibles.\n");
-            break;
-        }
-        else
-        {
-
-            int randIndex = rand() % emptyCountPC;
-            int x = emptyCellPC[randIndex][0];
-            int y = emptyCellPC[randIndex][1];
-            int z = emptyCellPC[randIndex][2];
-
-            // Déplacer la dernière case vide à la place de celle utilisée
-            emptyCellPC[randIndex][0] = emptyCellPC[emptyCountPC - 1][0];
-            emptyCellPC[randIndex][1] = emptyCellPC[emptyCountPC - 1][1];
-            emptyCellPC[randIndex][2] = emptyCellPC[emptyCountPC - 1][2];
-            --emptyCountPC;
-
-            int objet = rand() % 4;
-
-            switch (objet)
-            {
-            case CIGARETTE:
-                subgrids[x][y][z].object = CIGARETTE;
-                subgrids[x][y][z].texture = textures[CIGARETTE];
-                printf("L'ordinateur a trouvé une cigarette et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case BIERRE:
-                subgrids[x][y][z].object = BIERRE;
-                subgrids[x][y][z].texture = textures[BIERRE];
-                printf("L'ordinateur a trouvé une bière et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case LOUPE:
-                subgrids[x][y][z].object = LOUPE;
-                subgrids[x][y][z].texture = textures[LOUPE];
-                printf("L'ordinateur a trouvé une loupe et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case PILLULES:
-                subgrids[x][y][z].object = PILLULES;
-                subgrids[x][y][z].texture = textures[PILLULES];
-                printf("L'ordinateur a trouvé des pillule et les a mises dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            default:
-                printf("mauvais objet\n");
-                break;
-            }
-        }
-    }
-    for (int i = 0; i < nombreObjets; i++)
-    {
-        if (emptyCountJoueur == 0)
-        {
-            printf("Il n'y a plus de cases vides disponibles.\n");
-            break;
-        }
-        else
-        {
-            int randIndex = rand() % emptyCountJoueur;
-            int x = emptyCellJoueur[randIndex][0];
-            int y = emptyCellJoueur[randIndex][1];
-            int z = emptyCellJoueur[randIndex][2];
-
-            // Déplacer la dernière case vide à la place de celle utilisée
-            emptyCellJoueur[randIndex][0] = emptyCellJoueur[emptyCountJoueur - 1][0];
-            emptyCellJoueur[randIndex][1] = emptyCellJoueur[emptyCountJoueur - 1][1];
-            emptyCellJoueur[randIndex][2] = emptyCellJoueur[emptyCountJoueur - 1][2];
-            --emptyCountJoueur;
-
-            int objet = rand() % 4;
-
-            switch (objet)
-            {
-            case CIGARETTE:
-                subgrids[x][y][z].object = CIGARETTE;
-                subgrids[x][y][z].texture = textures[CIGARETTE];
-                printf("Le joueur a trouvé une cigarette et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case BIERRE:
-                subgrids[x][y][z].object = BIERRE;
-                subgrids[x][y][z].texture = textures[BIERRE];
-                printf("Le joueur a trouvé une bière et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case LOUPE:
-                subgrids[x][y][z].object = LOUPE;
-                subgrids[x][y][z].texture = textures[LOUPE];
-                printf("Le joueur a trouvé une loupe et l'a mise dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            case PILLULES:
-                subgrids[x][y][z].object = PILLULES;
-                subgrids[x][y][z].texture = textures[PILLULES];
-                printf("Le joueur a trouvé des pillule et les a mises dans la case %d\n", subgrids[x][y][z].id);
-                break;
-            default:
-                printf("mauvais objet\n");
-                break;
-            }
-        }
-    }
-}
-
-int generateRandomAmount() {
-    return (rand() % 701) + 500; // Génère un nombre entre 500 et 1200
-}
-
-#define MAX_NAME_LENGTH 100
-
-// Structure pour stocker les informations du joueur
-typedef struct {
-    char name[MAX_NAME_LENGTH];
-} Player;
-
-// Fonction pour demander le prénom du joueur
-void askPlayerName(Player *player) {
-    printf("Veuillez entrer votre prénom: ");
-    fgets(player->name, MAX_NAME_LENGTH, stdin);
-
-    // Supprimer le caractère de nouvelle ligne à la fin
-    size_t len = strlen(player->name);
-    if (len > 0 && player->name[len-1] == '\n') {
-        player->name[len-1] = '\0';
-    }
+    return true;
 }
 
-// Fonction pour sauvegarder le score dans un fichier texte
+// Fonction pour sauvegarder le score dans le journal des scores
 void saveScore(int score, const Player *player) {
-    FILE *file = fopen("scores.txt", "a"); // Ouvre le fichier en mode ajout
-    if (file == NULL) {
-        fprintf(stderr, "Erreur d'ouverture du fichier des scores.\n");
-        return;
+    if (!gScoresOpen || !scoresAjouter(&gScores, player->name, score)) {
+        fprintf(stderr, "Erreur d'enregistrement du score.\n");
     }
-    fprintf(file, "%s, %d\n", player->name, score);
-    fclose(file);
 }
 
 // Appeler cette fonction lorsque le joueur gagne
-void onPlayerWin(Player *player) {
-    int score = generateRandomAmount();
+void onPlayerWin(Player *player, Alea *alea) {
+    int score = generateRandomAmount(alea);
     saveScore(score, player);
     printf("Félicitations %s! Vous avez gagné %d$.\n", player->name, score);
 }
@@ -619,7 +195,8 @@ bool initializeSDL()
         return false;
     }
 
-    gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+    // La synchronisation verticale limite les affichages à la fréquence de l'écran
+    gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (gRenderer == NULL) {
         fprintf(stderr, "Renderer could not be created! SDL Error: %s\n", SDL_GetError());
         SDL_DestroyWindow(gWindow);
@@ -627,11 +204,14 @@ bool initializeSDL()
         return false;
     }
 
-    if (!loadMedia())
+    // Images et police chargées une fois pour tout le programme
+    if (!assetsLoad(gRenderer))
     {
         closeSDL();
         return false;
     }
+    // Sans journal ouvert (replays), la liste reste vide
+    scoreboardInit(&gScoreboard, gScoresOpen ? &gScores : NULL, assetFont(), gScoreListRect, 30);
 
     // Initialize button rectangles
     gLaunchButtonRect.x = (WINDOW_WIDTH - BUTTON_WIDTH) / 2;
@@ -657,55 +237,42 @@ bool initializeSDL()
     gTitleRect.w = titleWidth;
     gTitleRect.h = titleHeight;
 
+    // Tables de clic construites une fois, les boutons ne bougent plus
+    hitmapInit(&gMenuHits);
+    hitmapAdd(&gMenuHits, BUTTON_LAUNCH, gLaunchButtonRect);
+    hitmapAdd(&gMenuHits, BUTTON_SCOREBOARD, gScoreboardButtonRect);
+    hitmapAdd(&gMenuHits, BUTTON_QUIT, gQuitButtonRect);
+    hitmapInit(&gScoreboardHits);
+    hitmapAdd(&gScoreboardHits, BUTTON_RETURN, gReturnButtonRect);
+
     return true;
 }
 
-// Load textures
-bool loadMedia()
+// Note les étapes du démarrage atteintes ; avec --startup-times, les affiche quand les deux sont connues
+void updateStartupTimes(bool framePresented)
 {
-    gTitleTexture = loadTexture(gRenderer, "images/title.png");
-    if (gTitleTexture == NULL)
-    {
-        fprintf(stderr, "Failed to load title texture!\n");
-        return false;
-    }
-
-    gLaunchButtonTexture = loadTexture(gRenderer, "images/launch_button.png");
-    if (gLaunchButtonTexture == NULL)
-    {
-        fprintf(stderr, "Failed to load launch button texture!\n");
-        return false;
+    static bool printed = false;
+    if (printed) {
+        return;
     }
-
-    gScoreboardButtonTexture = loadTexture(gRenderer, "images/scoreboard.png");
-    if (gScoreboardButtonTexture == NULL) {
-        printf("Failed to load scoreboard button texture!\n");
-        return false;
+    if (framePresented && gFirstFrameNs == 0) {
+        gFirstFrameNs = chronoMaintenant() - gProcessStart;
     }
-
-    gQuitButtonTexture = loadTexture(gRenderer, "images/quit_button.png");
-    if (gQuitButtonTexture == NULL)
-    {
-        fprintf(stderr, "Failed to load quit button texture!\n");
-        return false;
+    if (gGameReadyNs == 0 && assetsPageReady(ATLAS_PAGE_GAME)) {
+        gGameReadyNs = chronoMaintenant() - gProcessStart;
     }
-
-    gReturnTexture = loadTexture(gRenderer, "images/retour.png");
-    if (gReturnTexture == NULL) {
-        fprintf(stderr, "Failed to load return button texture!\n");
-        return false;
+    if (gStartupTimes && gFirstFrameNs != 0 && gGameReadyNs != 0) {
+        printf("Première image : %.1f ms, jeu prêt : %.1f ms\n", gFirstFrameNs / 1e6, gGameReadyNs / 1e6);
+        printed = true;
     }
-    return true;
-
-    return true;
 }
 
 // Close SDL and free resources
 void closeSDL()
 {
-    SDL_DestroyTexture(gTitleTexture);
-    SDL_DestroyTexture(gLaunchButtonTexture);
-    SDL_DestroyTexture(gQuitButtonTexture);
+    scoreboardFree(&gScoreboard);
+    textFieldFree(&gNameField);
+    assetsFree();
     SDL_DestroyRenderer(gRenderer);
     SDL_DestroyWindow(gWindow);
     SDL_Quit();
@@ -714,338 +281,288 @@ void closeSDL()
 // Render title on the screen
 void renderTitle()
 {
-    SDL_RenderCopy(gRenderer, gTitleTexture, NULL, &gTitleRect);
+    assetDraw(gRenderer, TEXTURE_TITLE, &gTitleRect);
 }
 
 // Render buttons on the screen
 void renderButtons() {
     // Afficher le bouton "Jouer"
-    SDL_RenderCopy(gRenderer, gLaunchButtonTexture, NULL, &gLaunchButtonRect);
+    assetDraw(gRenderer, TEXTURE_LAUNCH_BUTTON, &gLaunchButtonRect);
     
     // Afficher le bouton "Scoreboard"
-    SDL_RenderCopy(gRenderer, gScoreboardButtonTexture, NULL, &gScoreboardButtonRect);
+    assetDraw(gRenderer, TEXTURE_SCOREBOARD_BUTTON, &gScoreboardButtonRect);
     
     // Afficher le bouton "Quitter"
-    SDL_RenderCopy(gRenderer, gQuitButtonTexture, NULL, &gQuitButtonRect);
+    assetDraw(gRenderer, TEXTURE_QUIT_BUTTON, &gQuitButtonRect);
 }
 
-// Render game content on the screen
-bool renderGame(Player *player) {
-    SDL_Texture *imageTexture = NULL;
-
-    if (TTF_Init() == -1) {
-        printf("SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
-        SDL_Quit();
-        return 1;
+// Nom de chaque dealer pour --dealer, et la politique qui le joue (aussi pour relire les replays)
+const struct {
+    const char *name;
+    Politique politique;
+} gDealers[NB_DEALERS] = {
+    [DEALER_HEURISTIQUE] = {"heuristique", politiqueHeuristique},
+    [DEALER_EXPECTIMAX] = {"expectimax", politiqueExpectimax},
+    [DEALER_TABLE] = {"table", politiqueTable},
+};
+
+Dealer dealerCourant()
+{
+    for (int d = 0; d < NB_DEALERS; d++) {
+        if (gDealers[d].politique == gPolitiqueOrdi) {
+            return (Dealer)d;
+        }
     }
+    return DEALER_HEURISTIQUE;
+}
 
-    TTF_Font *font = TTF_OpenFont("arial.ttf", 20);
-    if (font == NULL) {
-        printf("Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
-        TTF_Quit();
-        SDL_Quit();
-        return 1;
+// Écrit le replay de la partie dans le dossier donné par --record
+void saveReplay(Replay *replay, const Jeu *jeu)
+{
+    if (gReplayDir == NULL) {
+        return;
     }
-
-    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
-        SDL_Quit();
-        return 1;
+    char path[512];
+    replayTerminer(replay, jeu);
+    snprintf(path, sizeof(path), "%s/%llu" REPLAY_EXTENSION, gReplayDir, (unsigned long long)jeu->graine);
+    if (replayEcrire(replay, path)) {
+        printf("Replay enregistré dans %s\n", path);
     }
+}
 
-    SDL_Texture *textures[4];
-    textures[CIGARETTE] = loadTexture(gRenderer, "images/cigarette.png");
-    textures[BIERRE] = loadTexture(gRenderer, "images/biere.png");
-    textures[LOUPE] = loadTexture(gRenderer, "images/loupe.png");
-    textures[PILLULES] = loadTexture(gRenderer, "images/pillules.png");
-
-    for (int i = 0; i < 4; ++i) {
-        if (textures[i] == NULL) {
-            for (int j = 0; j < 4; ++j) {
-                if (textures[j] != NULL) {
-                    SDL_DestroyTexture(textures[j]);
-                }
-            }
-            SDL_DestroyRenderer(gRenderer);
-            SDL_DestroyWindow(gWindow);
-            IMG_Quit();
-            SDL_Quit();
-            return 1;
-        }
+// Résout les débuts de manche en fond ; d'ici là, le dealer résout lui-même les positions qu'il
+// rencontre (mêmes décisions, un peu plus lentes) et les chances de victoire attendent la table
+void *warmAi(void *unused)
+{
+    (void)unused;
+    prechaufferIa();
+    if (gAiReadyEvent != (Uint32)-1) {
+        SDL_Event event = {.type = gAiReadyEvent};
+        SDL_PushEvent(&event);
     }
+    return NULL;
+}
 
-    imageTexture = loadTexture(gRenderer, "images/pompe.png");
-    if (imageTexture == NULL) {
-        printf("Unable to create texture from image! SDL Error: %s\n", SDL_GetError());
-        SDL_DestroyRenderer(gRenderer);
-        SDL_DestroyWindow(gWindow);
-        IMG_Quit();
-        SDL_Quit();
-        return 1;
+void startWarmingAi()
+{
+    if (gPolitiqueOrdi != politiqueExpectimax) {
+        return;
     }
+    gAiReadyEvent = SDL_RegisterEvents(1);
+    gWarmStarted = pthread_create(&gWarmThread, NULL, warmAi, NULL) == 0;
+    if (!gWarmStarted) {
+        prechaufferIa();
+    }
+}
 
+// Partie en cours : tout ce qui dure d'un événement à l'autre tant que la partie n'est pas finie
+typedef struct {
+    GridCell grid[GRID_ROWS][GRID_COLS];
+    GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS];
+    GridCell extraCells[2];
     SDL_Rect imageRect;
-    imageRect.x = CELL_WIDTH + CELL_WIDTH / 2 - CELL_WIDTH / 4;
-    imageRect.y = CELL_HEIGHT / 2;
-    imageRect.w = CELL_WIDTH / 2;
-    imageRect.h = CELL_HEIGHT;
+    HitMap hits;
+    TextCache hud[HUD_LINES];
+    TextCache stats[STATS_LINES];
+    TextCache odds[ODDS_LINES];
+    Estimation estimation;
+    uint64_t oddsShown;
+    Jeu jeu;
+    Replay replay;
+} GameScreen;
+
+GameScreen gGame;
+
+bool enterGame() {
+    // Les textures et la police viennent du gestionnaire de ressources : au pire, attendre
+    // la fin du décodage de la page du jeu si le joueur a été plus rapide
+    if (!assetsWait(gRenderer, ATLAS_PAGE_GAME)) {
+        return false;
+    }
+    GameScreen *game = &gGame;
+    buildGameLayout(game->grid, game->subgrids, game->extraCells, &game->imageRect, &game->hits);
+    memset(game->hud, 0, sizeof(game->hud));
+    memset(game->stats, 0, sizeof(game->stats));
+    memset(game->odds, 0, sizeof(game->odds));
+    memset(&game->estimation, 0, sizeof(game->estimation));
+    game->oddsShown = 0;
+
+    // Une graine par partie, affichée pour pouvoir rejouer la même donne avec --seed
+    uint64_t graine = nouvelleGraine();
+    printf("Graine de la partie : %llu\n", (unsigned long long)graine);
+    jeuDemarrer(&game->jeu, graine, gPolitiqueOrdi, true);
+    game->jeu.chronos = &gChronos;
+    replayCommencer(&game->replay, graine, dealerCourant());
+    estimationDemander(&gEstimateur, &game->jeu.partie);
+
+    // Une image va du réveil par un événement jusqu'à la fin de l'affichage qui en découle ;
+    // l'attente des événements n'est pas comptée
+    chronoDebutImage(&gChronos);
+    return true;
+}
 
-    GridCell grid[GRID_ROWS][GRID_COLS];
-    int idCounter = 0;
-    for (int i = 0; i < GRID_ROWS; ++i) {
-        for (int j = 0; j < GRID_COLS; ++j) {
-            grid[i][j].rect = (SDL_Rect){j * CELL_WIDTH, i * CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT};
-            grid[i][j].clicked = false;
-            grid[i][j].id = idCounter++;
-            grid[i][j].texture = NULL;
-        }
+// Partie gagnée : retour au menu ; perdue : le programme se ferme
+GameState gameNextState(const Jeu *jeu) {
+    switch (jeu->etat) {
+        case JEU_GAGNE:
+            return STATE_MENU;
+        case JEU_PERDU:
+            return STATE_QUIT;
+        default:
+            return STATE_GAME;
     }
+}
 
-    GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS];
-    SDL_Rect subgrid_positions[4] = {
-        {0, 0, CELL_WIDTH, CELL_HEIGHT},
-        {CELL_WIDTH * 2, 0, CELL_WIDTH, CELL_HEIGHT},
-        {0, CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT},
-        {CELL_WIDTH * 2, CELL_HEIGHT, CELL_WIDTH, CELL_HEIGHT}};
-
-    for (int g = 0; g < 4; ++g) {
-        for (int i = 0; i < SUBGRID_ROWS; ++i) {
-            for (int j = 0; j < SUBGRID_COLS; ++j) {
-                subgrids[g][i][j].rect = (SDL_Rect){
-                    subgrid_positions[g].x + SUBGRID_MARGIN + j * (SUBGRID_CELL_WIDTH + SUBGRID_MARGIN),
-                    subgrid_positions[g].y + SUBGRID_MARGIN + i * (SUBGRID_CELL_HEIGHT + SUBGRID_MARGIN),
-                    SUBGRID_CELL_WIDTH,
-                    SUBGRID_CELL_HEIGHT};
-                subgrids[g][i][j].clicked = false;
-                subgrids[g][i][j].id = idCounter++;
-                subgrids[g][i][j].texture = NULL;
-            }
+GameState updateGame(const SDL_Event *e) {
+    GameScreen *game = &gGame;
+    if (e == NULL) {
+        // Nouvelles parties simulées depuis le dernier affichage : les chances ont changé
+        estimationLire(&gEstimateur, &game->estimation);
+        if (game->estimation.parties[CIBLE_ADVERSAIRE] != game->oddsShown) {
+            gNeedsRedraw = true;
+        }
+        gWaitMs = game->estimation.enCours ? ODDS_REFRESH_MS : EVENT_WAIT_TIMEOUT_MS;
+    } else if (e->type == SDL_KEYDOWN && e->key.keysym.sym == SDLK_F3) {
+        gShowFrameStats = !gShowFrameStats;
+        gNeedsRedraw = true;
+    } else if (e->type == gAiReadyEvent) {
+        // La table de l'expectimax vient d'être publiée : l'estimation peut enfin commencer
+        estimationDemander(&gEstimateur, &game->jeu.partie);
+    } else if (e->type == SDL_MOUSEBUTTONDOWN) {
+        int idCase = handleMouseClick(&game->hits, e->button.x, e->button.y);
+        TRACE_DEBUG(TRACE_ENTREES, "Clic en (%d, %d) : case %d", e->button.x, e->button.y, idCase);
+        // Le replay garde chaque clic sur une case : la graine et cette suite suffisent à rejouer la partie
+        replayAjouter(&game->replay, idCase);
+        if (jeuCliquer(&game->jeu, idCase)) {
+            // Le dealer a fini de jouer : estimer le nouvel état pendant que le joueur réfléchit
+            estimationDemander(&gEstimateur, &game->jeu.partie);
+            gNeedsRedraw = true;
         }
     }
+    return gameNextState(&game->jeu);
+}
 
-    GridCell extraCells[2] = {
-        {{SCREEN_WIDTH - 100, 0, 100, SCREEN_HEIGHT / 2}, false, idCounter++, Null, NULL},
-        {{SCREEN_WIDTH - 100, SCREEN_HEIGHT / 2, 100, SCREEN_HEIGHT / 2}, false, idCounter++, Null, NULL}};
-
+void renderGame() {
+    GameScreen *game = &gGame;
+    TTF_Font *font = assetFont();
+    uint64_t debut = chronoDebut(&gChronos);
     SDL_SetRenderDrawColor(gRenderer, 255, 255, 255, 255);
     SDL_RenderClear(gRenderer);
+    drawGrid(gRenderer, game->grid, game->subgrids, game->extraCells, font, game->hud, &game->jeu.partie, &game->imageRect);
+    drawWinOdds(gRenderer, game->extraCells, font, game->odds, &game->estimation);
+    game->oddsShown = game->estimation.parties[CIBLE_ADVERSAIRE];
+    if (gShowFrameStats) {
+        drawFrameStats(gRenderer, game->extraCells, font, game->stats, &gChronos);
+    }
+    chronoFin(&gChronos, ETAPE_DESSIN, debut);
+    debut = chronoDebut(&gChronos);
+    SDL_RenderPresent(gRenderer);
+    chronoFin(&gChronos, ETAPE_PRESENTATION, debut);
+}
 
-    // Initialiser les variables
-    int balles[8];
-    int rouges = 0, noirs = 0, nombreDeBalles = 0;
-    SDL_Event e;
-    bool quitGame = false;
-    int vieJoueur, vieOrdi;
-    bool joueurDoitRejouer = false;
-    bool ordinateurDoitRejouer = false;
-    bool joueurTurn = true;
-    int x, y;
-    int manche = 1;
+// Fin de partie, quelle qu'en soit la raison (victoire, défaite, fenêtre fermée)
+void leaveGame() {
+    GameScreen *game = &gGame;
+    estimationAnnuler(&gEstimateur);
+    saveReplay(&game->replay, &game->jeu);
+    replayLiberer(&game->replay);
 
-    drawGrid(gRenderer, grid, subgrids, extraCells, font, rouges, noirs, nombreDeBalles, manche, vieJoueur, vieOrdi);
+    if (game->jeu.etat == JEU_GAGNE) {
+        onPlayerWin(&gPlayer, &game->jeu.alea);
+    }
 
-    SDL_RenderPresent(gRenderer);
+    // Libération des ressources
+    freeTextCache(game->hud, HUD_LINES);
+    freeTextCache(game->stats, STATS_LINES);
+    freeTextCache(game->odds, ODDS_LINES);
+}
 
-    srand(time(NULL));
+// Rejoue un replay à l'écran, un clic toutes les REPLAY_RENDER_DELAY_MS
+bool renderReplay(const Replay *replay, Jeu *jeu)
+{
+    GridCell grid[GRID_ROWS][GRID_COLS];
+    GridCell subgrids[4][SUBGRID_ROWS][SUBGRID_COLS];
+    GridCell extraCells[2];
+    SDL_Rect imageRect;
+    HitMap hits;
+    buildGameLayout(grid, subgrids, extraCells, &imageRect, &hits);
 
-    while (!quitGame && manche <= 3)
-    {
-        printf("while quit/manche\n");
-        if(vieJoueur <= 0 || vieOrdi <= 0){
-        vieJoueur = 3 + rand() % 4; // Vie du joueur entre 3 et 6
-        vieOrdi = vieJoueur;}
-        printf("Manche %d: Vie Joueur = %d, Vie Ordi = %d\n", manche, vieJoueur, vieOrdi);
+    TextCache hud[HUD_LINES] = {0};
+    SDL_Event e;
+    bool quitReplay = !assetsWait(gRenderer, ATLAS_PAGE_GAME);
 
-        genererBalles(balles, &rouges, &noirs, &nombreDeBalles);
-        giveObject(subgrids, textures);
+    for (uint32_t i = 0; i <= replay->entete.nbCases && !quitReplay; i++)
+    {
+        if (i > 0)
+        {
+            jeuCliquer(jeu, replay->cases[i - 1]);
+        }
+        drawGrid(gRenderer, grid, subgrids, extraCells, assetFont(), hud, &jeu->partie, &imageRect);
+        SDL_RenderPresent(gRenderer);
 
-        while (!quitGame && (vieJoueur > 0 && vieOrdi > 0))
+        Uint32 fin = SDL_GetTicks() + REPLAY_RENDER_DELAY_MS;
+        while (!quitReplay && SDL_GetTicks() < fin)
         {
-            while (SDL_PollEvent(&e) != 0)
+            if (SDL_WaitEventTimeout(&e, (int)(fin - SDL_GetTicks())) && e.type == SDL_QUIT)
             {
-                if (e.type == SDL_QUIT)
-                {
-                    quitGame = true;
-                }
-                else if (e.type == SDL_MOUSEBUTTONDOWN)
-                {
-                    SDL_GetMouseState(&x, &y);
-                    int idCase = handleMouseClick(x, y, grid, subgrids, extraCells);
-                    printf("ID de la case cliquée: %d\n", idCase);
-                    if (joueurTurn)
-                    {
-                        if (idCase == 1 || idCase == 4)
-                        {
-                            joueurDoitRejouer = joueurTour(idCase, &vieJoueur, &vieOrdi, &rouges, &noirs, &nombreDeBalles, balles);
-                            if (!joueurDoitRejouer)
-                            {
-                                joueurTurn = false;
-                            }
-                        }
-                        else if (idCase >= 14 && idCase <= 21)
-                        {
-                            printf("Object");
-                            int x, y, z;
-                            // si la case qui a été cliqué est une case avec un objet alors on enleve l'objet de la case et on utilise l'objet
-                            if (idCase >= 14 && idCase <= 17)
-                            {
-                                x = 2;
-                                if (idCase == 14 || idCase == 15)
-                                {
-                                    y = 0;
-                                }
-                                else if (idCase == 16 || idCase == 17)
-                                {
-                                    y = 1;
-                                }
-                                if (idCase == 14 || idCase == 16)
-                                {
-                                    z = 0;
-                                }
-                                else if (idCase == 15 || idCase == 17)
-                                {
-                                    z = 1;
-                                }
-                                printf("x = %d, y = %d, z = %d\n", x, y, z);
-                            }
-                            else if (idCase >= 18 && idCase <= 21)
-                            {
-                                x = 3;
-                                if (idCase == 18 || idCase == 19)
-                                {
-                                    y = 0;
-                                }
-                                else if (idCase == 20 || idCase == 21)
-                                {
-                                    y = 1;
-                                }
-                                if (idCase == 18 || idCase == 20)
-                                {
-                                    z = 0;
-                                }
-                                else if (idCase == 19 || idCase == 21)
-                                {
-                                    z = 1;
-                                }
-                                printf("x = %d, y = %d, z = %d\n", x, y, z);
-                            }
-                            if (subgrids[x][y][z].object == CIGARETTE)
-                            {
-                                printf("le joueur a utilisé une cigarette et a gagné une vie\n");
-                                vieJoueur++;
-                            }
-                            else if (subgrids[x][y][z].object == BIERRE)
-                            {
-                                printf("le joueur a utilisé une bière et passe donc a la balle suivante\n");
-                                if (balles[0] == ROUGE)
-                                {
-                                    rouges--;
-                                }
-                                else
-                                {
-                                    noirs--;
-                                }
-                                for (int i = 0; i < nombreDeBalles; i++)
-                                {
-                                    balles[i] = balles[i + 1];
-                                }
-                                balles[nombreDeBalles] = -1;
-                                nombreDeBalles--;
-                            }
-                            else if (subgrids[x][y][z].object == LOUPE)
-                            {
-                                printf("le joueur a utilisé une loupe et a vu la couleur de la prochaine balle\n");
-                                printf("La prochaine balle est %s\n", balles[0] == ROUGE ? "Rouge" : "Noir");
-                            }
-                            else if (subgrids[x][y][z].object == PILLULES)
-                            {
-                                int choix = rand() % 2;
-                                if (choix == 0)
-                                {
-                                    vieJoueur -= 2;
-                                    printf("le joueur a utilisé des pillules et a perdu 2 vies\n");
-                                }
-                                else
-                                {
-                                    vieJoueur += 2;
-                                    printf("le joueur a utilisé des pillules et a gagné 2 vies\n");
-                                }
-                                joueurTurn = true;
-                            }
-                            subgrids[x][y][z].object = Null;
-                            subgrids[x][y][z].texture = NULL;
-                        }
-                    }
-                }
+                quitReplay = true;
             }
+        }
+    }
 
-            if (nombreDeBalles == 0)
-            {
-                genererBalles(balles, &rouges, &noirs, &nombreDeBalles);
-                giveObject(subgrids, textures);
-            }
+    freeTextCache(hud, HUD_LINES);
+    return !quitReplay;
+}
 
-            // Logique pour l'ordinateur
-            if (!joueurTurn)
-            {
-                ordinateurDoitRejouer = ordinateurTour(&vieJoueur, &vieOrdi, &rouges, &noirs, &nombreDeBalles, balles);
-                if (ordinateurDoitRejouer)
-                {
-                    joueurTurn = false;
-                }
-                else
-                {
-                    joueurTurn = true;
-                }
-            }
+// --replay : rejoue chaque fichier avec le code actuel des règles et vérifie qu'il aboutit
+// au même état final ; sans --render, aucune fenêtre n'est ouverte et tout va à pleine vitesse
+int runReplays(char **files, int count, bool render)
+{
+    if (render && !initializeSDL()) {
+        return 1;
+    }
 
-            if (nombreDeBalles == 0)
-            {
-                genererBalles(balles, &rouges, &noirs, &nombreDeBalles);
-                giveObject(subgrids, textures);
-            }
+    int divergences = 0;
+    int verified = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < count; f++) {
+        Replay replay;
+        if (!replayLire(&replay, files[f])) {
+            divergences++;
+            continue;
+        }
 
-            SDL_SetRenderDrawColor(gRenderer, 255, 255, 255, 255);
-            SDL_RenderClear(gRenderer);
-            drawGrid(gRenderer, grid, subgrids, extraCells, font, rouges, noirs, nombreDeBalles, manche, vieJoueur, vieOrdi);
-            SDL_RenderCopy(gRenderer, imageTexture, NULL, &imageRect);
-            SDL_RenderPresent(gRenderer);
+        if (replay.entete.dealer >= NB_DEALERS) {
+            fprintf(stderr, "%s : dealer inconnu (%u)\n", files[f], replay.entete.dealer);
+            replayLiberer(&replay);
+            divergences++;
+            continue;
         }
+        Politique politique = gDealers[replay.entete.dealer].politique;
+        Jeu jeu;
+        jeuDemarrer(&jeu, replay.entete.graine, politique, render);
 
-        if (vieJoueur <= 0)
-        {
-            printf("Vous avez perdu face au Dealer %d.\n", manche);
-            quitGame = true;
+        if (render && !renderReplay(&replay, &jeu)) {
+            replayLiberer(&replay);
+            break;
         }
-        else
-        {
-            manche++;
+        bool identical = render ? replayConforme(&replay, &jeu) : replayVerifier(&replay, &jeu);
+        if (!identical) {
+            fprintf(stderr, "%s : divergence (graine %llu, %u clics)\n", files[f],
+                    (unsigned long long)replay.entete.graine, replay.entete.nbCases);
+            divergences++;
         }
+        verified++;
+        replayLiberer(&replay);
     }
 
-    if (manche > 3 && vieJoueur > 0)
-    {
-        printf("Vous avez gagné les 3 manches !\n");
-        onPlayerWin(player);
-        quitGame = false;
-    }
+    double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    printf("%d replays vérifiés en %.3f s, %d divergence(s)\n", verified, seconds, divergences);
 
-    // Libération des ressources
-    SDL_DestroyTexture(imageTexture);
-    for (int i = 0; i < 4; ++i)
-    {
-        if (textures[i] != NULL)
-        {
-            SDL_DestroyTexture(textures[i]);
-        }
+    if (render) {
+        closeSDL();
     }
-    SDL_DestroyRenderer(gRenderer);
-    SDL_DestroyWindow(gWindow);
-    IMG_Quit();
-    TTF_Quit();
-    SDL_Quit();
-
-    return quitGame;
+    return divergences == 0 ? 0 : 1;
 }
 
 void renderMenu()
@@ -1057,155 +574,231 @@ void renderMenu()
     SDL_RenderPresent(gRenderer);
 }
 
-// Fonction pour rendre le scoreboard
-void renderScoreboard() {
-    if (TTF_Init() == -1) {
-        fprintf(stderr, "Failed to initialize SDL_ttf! SDL_ttf Error: %s\n", TTF_GetError());
-        return;
+// Clic sur un bouton du menu ou du scoreboard : l'état qu'il désigne
+GameState clickButton(const HitMap *hits, const SDL_Event *e, GameState current) {
+    if (e == NULL || e->type != SDL_MOUSEBUTTONDOWN) {
+        return current;
     }
+    int button = hitmapFind(hits, e->button.x, e->button.y);
+    return button >= 0 ? buttonTargets[button] : current;
+}
 
-    FILE *file = fopen("scores.txt", "r");
-    if (file == NULL) {
-        // Si le fichier n'existe pas, on le cree et on le reouvre
-        file = fopen("scores.txt", "w");
-        if (file == NULL) {
-        fprintf(stderr, "Erreur d'ouverture du fichier des scores.\n");
-        TTF_Quit();
-        return;
-        }
+GameState updateMenu(const SDL_Event *e) {
+    return clickButton(&gMenuHits, e, STATE_MENU);
+}
+
+void renderNameEntry()
+{
+    SDL_SetRenderDrawColor(gRenderer, 0, 0, 0, 255);
+    SDL_RenderClear(gRenderer);
+    renderTitle();
+    textFieldRender(gRenderer, &gNameField, assetFont(), "Entrez votre prénom puis Entrée (Échap : retour)");
+    SDL_RenderPresent(gRenderer);
+}
+
+GameState updateScoreboard(const SDL_Event *e) {
+    // Le compteur du journal partagé suffit ; le réveil périodique de la boucle montre
+    // les scores des autres instances
+    if (e == NULL) {
+        gNeedsRedraw = scoreboardRefresh(&gScoreboard) || gNeedsRedraw;
+        gWaitMs = SCORES_POLL_MS;
     }
+    if (e != NULL && scoreboardScroll(&gScoreboard, e)) {
+        gNeedsRedraw = true;
+    }
+    return clickButton(&gScoreboardHits, e, STATE_SCOREBOARD);
+}
 
+// Fonction pour rendre le scoreboard
+void renderScoreboard() {
     SDL_SetRenderDrawColor(gRenderer, 0, 0, 0, 255);
     SDL_RenderClear(gRenderer);
 
-    SDL_Color textColor = {255, 255, 255, 255};
-    TTF_Font *font = TTF_OpenFont("arial.ttf", 20);
-    if (font == NULL) {
-        fprintf(stderr, "Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
-        fclose(file);
-        TTF_Quit();
+    // Seules les lignes visibles sont lues et dessinées, quelle que soit la taille du journal
+    scoreboardRender(&gScoreboard, gRenderer);
+
+    // afficher le bouton retour 
+    assetDraw(gRenderer, TEXTURE_RETURN, &gReturnButtonRect);
+
+    SDL_RenderPresent(gRenderer);
+}
+
+// Ce que fait chaque état de la boucle principale. update reçoit chaque événement, puis une
+// fois par tour de boucle NULL (réveil sans événement : délai écoulé, ressources arrivées) ;
+// il retourne l'état suivant. render n'est appelé que si gNeedsRedraw.
+typedef struct {
+    bool (*enter)(void); // false : l'état ne peut pas commencer, le programme se ferme
+    GameState (*update)(const SDL_Event *e);
+    void (*render)(void);
+    void (*leave)(void);
+    bool timed; // images mesurées dans gChronos (F3, --frame-stats)
+} Screen;
+
+const Screen gScreens[STATE_QUIT] = {
+    [STATE_MENU] = {NULL, updateMenu, renderMenu, NULL, false},
+    [STATE_NAME_ENTRY] = {beginNameEntry, updateNameEntry, renderNameEntry, endNameEntry, false},
+    [STATE_GAME] = {enterGame, updateGame, renderGame, leaveGame, true},
+    [STATE_SCOREBOARD] = {NULL, updateScoreboard, renderScoreboard, NULL, false},
+};
+
+void changeState(GameState next) {
+    if (next == currentState) {
         return;
     }
+    if (gScreens[currentState].leave != NULL) {
+        gScreens[currentState].leave();
+    }
+    currentState = next;
+    gNeedsRedraw = true;
+    if (next != STATE_QUIT && gScreens[next].enter != NULL && !gScreens[next].enter()) {
+        currentState = STATE_QUIT;
+    }
+}
 
-    int y = 50;
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\n")] = 0; // Enlever le caractère de nouvelle ligne
-        SDL_Surface *textSurface = TTF_RenderText_Solid(font, line, textColor);
-        if (textSurface == NULL) {
-            fprintf(stderr, "Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError());
+// Une seule boucle pour tous les écrans : elle dort dans SDL_WaitEventTimeout tant que rien
+// n'arrive, et chaque événement lu va à l'état courant, même s'il vient de changer
+void runMainLoop() {
+    SDL_Event e;
+    currentState = STATE_MENU;
+    gNeedsRedraw = true;
+
+    while (currentState != STATE_QUIT) {
+        // Pages de l'atlas décodées entre-temps : seul l'envoi au renderer se fait ici
+        bool uploaded = false;
+        if (!assetsPoll(gRenderer, &uploaded)) {
+            changeState(STATE_QUIT);
+            break;
+        }
+        gNeedsRedraw = gNeedsRedraw || uploaded;
+
+        gWaitMs = EVENT_WAIT_TIMEOUT_MS;
+        GameState next = gScreens[currentState].update(NULL);
+        if (next != currentState) {
+            changeState(next);
             continue;
         }
-        SDL_Texture *textTexture = SDL_CreateTextureFromSurface(gRenderer, textSurface);
-        if (textTexture == NULL) {
-            fprintf(stderr, "Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
-            SDL_FreeSurface(textSurface);
+
+        const Screen *screen = &gScreens[currentState];
+        bool presented = gNeedsRedraw;
+        if (gNeedsRedraw) {
+            screen->render();
+            gNeedsRedraw = false;
+        }
+        updateStartupTimes(presented);
+        if (screen->timed) {
+            chronoFinImage(&gChronos);
+            if (chronoFenetreTerminee(&gChronos) && gShowFrameStats) {
+                gNeedsRedraw = true;
+                continue;
+            }
+        }
+
+        // Dormir jusqu'au prochain événement au lieu de boucler à vide
+        if (!SDL_WaitEventTimeout(&e, gWaitMs)) {
             continue;
         }
-        SDL_Rect textRect = {50, y, textSurface->w, textSurface->h};
-        SDL_RenderCopy(gRenderer, textTexture, NULL, &textRect);
-        SDL_FreeSurface(textSurface);
-        SDL_DestroyTexture(textTexture);
-        y += 30;
+        if (screen->timed) {
+            chronoDebutImage(&gChronos);
+        }
+        do {
+            if (e.type == SDL_QUIT) {
+                next = STATE_QUIT;
+            } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_EXPOSED) {
+                gNeedsRedraw = true;
+                next = currentState;
+            } else {
+                next = gScreens[currentState].update(&e);
+            }
+            changeState(next);
+        } while (currentState != STATE_QUIT && SDL_PollEvent(&e));
     }
+}
 
-    fclose(file);
+int main(int argc, char *argv[]) {
+    // --dealer table|expectimax|heuristique : objets et tirs lus dans la table précalculée (par défaut),
+    //   objets et tirs optimaux cherchés en jeu, ou règle simple avec les objets de jouerObjets
+    // --seed N : toutes les parties utilisent la graine N (donne reproductible)
+    // --record dossier : chaque partie écrit son replay dans ce dossier
+    // --replay fichiers... [--render] : vérifie des replays sans fenêtre, ou les montre avec --render
+    // --frame-stats fichier.csv : temps de chaque étape des images de jeu, écrits en quittant (F3 les affiche)
+    // --startup-times : délai entre le lancement et la première image du menu, puis les images du jeu prêtes
+    gProcessStart = chronoMaintenant();
+    char **replayFiles = NULL;
+    int replayCount = 0;
+    bool renderReplays = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dealer") == 0 && i + 1 < argc) {
+            const char *mode = argv[++i];
+            int d = 0;
+            while (d < NB_DEALERS && strcmp(gDealers[d].name, mode) != 0) {
+                d++;
+            }
+            if (d == NB_DEALERS) {
+                fprintf(stderr, "Mode de dealer inconnu : %s (table, heuristique ou expectimax)\n", mode);
+                return 1;
+            }
+            gPolitiqueOrdi = gDealers[d].politique;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            gGraine = strtoull(argv[++i], NULL, 10);
+            gGraineFixee = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            gReplayDir = argv[++i];
+        } else if (strcmp(argv[i], "--frame-stats") == 0 && i + 1 < argc) {
+            gFrameStatsPath = argv[++i];
+        } else if (strcmp(argv[i], "--startup-times") == 0) {
+            gStartupTimes = true;
+        } else if (strcmp(argv[i], "--render") == 0) {
+            renderReplays = true;
+        } else if (strcmp(argv[i], "--replay") == 0) {
+            // Tous les arguments suivants qui ne sont pas des options sont des fichiers de replay
+            replayFiles = &argv[i + 1];
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                replayCount++;
+                i++;
+            }
+        }
+    }
 
-    // afficher le bouton retour 
-    SDL_Rect returnButtonRect = {50, 500, 100, 50};
-    SDL_Texture *returnButtonTexture = loadTexture(gRenderer, "images/retour.png");
-    SDL_RenderCopy(gRenderer, returnButtonTexture, NULL, &returnButtonRect);
+    if (replayFiles != NULL) {
+        return runReplays(replayFiles, replayCount, renderReplays);
+    }
 
-    TTF_CloseFont(font);
-    TTF_Quit();
+    // Les PNG se décodent en fond pendant tout le reste du démarrage, la table de l'expectimax aussi
+    assetsStartDecoding();
+    startWarmingAi();
 
-    SDL_RenderPresent(gRenderer);
-}
+    // Le récit de la partie part dans un thread de fond : la boucle d'affichage n'écrit jamais dans la console
+    traceDemarrer();
 
-int main() {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         fprintf(stderr, "SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+        traceArreter();
         return -1;
     }
 
+    // Le journal partagé des scores est ouvert avant la fenêtre : le scoreboard le lit directement
+    gScoresOpen = openScoreStore();
     if (!initializeSDL()) {
+        scoresFermer(&gScores);
+        traceArreter();
         return 1;
     }
+    chronoInit(&gChronos);
+    estimationDemarrer(&gEstimateur, 0, nouvelleGraine(), gPolitiqueOrdi);
 
-    SDL_Event e;
-    int currentState = STATE_MENU;
-    bool quit = false;
+    runMainLoop();
 
-    while (!quit) {
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                quit = true;
-            }
-        }
-
-        switch (currentState) {
-            case STATE_MENU:
-                renderMenu();
-                while (SDL_PollEvent(&e)) {
-                    if (e.type == SDL_QUIT) {
-                        quit = true;
-                    } else if (e.type == SDL_MOUSEBUTTONDOWN) {
-                        int mouseX, mouseY;
-                        SDL_GetMouseState(&mouseX, &mouseY);
-
-                        if (mouseX >= gLaunchButtonRect.x && mouseX <= (gLaunchButtonRect.x + gLaunchButtonRect.w) &&
-                            mouseY >= gLaunchButtonRect.y && mouseY <= (gLaunchButtonRect.y + gLaunchButtonRect.h)) {
-                            currentState = STATE_GAME;
-                        }
-
-                        if (mouseX >= gScoreboardButtonRect.x && mouseX <= (gScoreboardButtonRect.x + gScoreboardButtonRect.w) &&
-                            mouseY >= gScoreboardButtonRect.y && mouseY <= (gScoreboardButtonRect.y + gScoreboardButtonRect.h)) {
-                            currentState = STATE_SCOREBOARD;
-                        }
-
-                        if (mouseX >= gQuitButtonRect.x && mouseX <= (gQuitButtonRect.x + gQuitButtonRect.w) &&
-                            mouseY >= gQuitButtonRect.y && mouseY <= (gQuitButtonRect.y + gQuitButtonRect.h)) {
-                            quit = true;
-                        }
-                    }
-                }
-                break;
-
-            case STATE_GAME:
-                Player player;
-
-                // Demander le prénom du joueur
-                askPlayerName(&player);
-                if (renderGame(&player)) {
-                    currentState = STATE_QUIT;
-                } else {
-                    currentState = STATE_MENU;
-                }
-                break;
-
-            case STATE_SCOREBOARD:
-                renderScoreboard();
-                while (SDL_PollEvent(&e)) {
-                    if (e.type == SDL_QUIT) {
-                        quit = true;
-                    } else if (e.type == SDL_MOUSEBUTTONDOWN) {
-                        int mouseX, mouseY;
-                        SDL_GetMouseState(&mouseX, &mouseY);
-
-                        // Vérifiez si le bouton "Retour" est cliqué
-                        if (mouseX >= 50 && mouseX <= 150 && mouseY >= 500 && mouseY <= 550) {
-                            currentState = STATE_MENU;
-                        }
-                    }
-                }
-                break;
-
-            case STATE_QUIT:
-                quit = true;
-                break;
-        }
+    if (gFrameStatsPath != NULL) {
+        chronoEcrireCsv(&gChronos, gFrameStatsPath);
+    }
+    estimationArreter(&gEstimateur);
+    // Le préchauffage pousse encore un événement SDL en finissant : l'attendre avant SDL_Quit
+    if (gWarmStarted) {
+        pthread_join(gWarmThread, NULL);
     }
-
     closeSDL();
+    scoresFermer(&gScores);
+    libererIa();
+    traceArreter();
     return 0;
 }
@@ -0,0 +1,310 @@
+// Construction de l'atlas : assemble les images du jeu dans une image par page
+// et écrit la table des rectangles source de chaque image dans sa page.
+//
+// Usage : Buckshot_Atlas <atlas_menu.png> <atlas_jeu.png> <atlas.h>
+//
+// Deux pages : celle du menu (titre, boutons) est petite pour être prête dès la première
+// image, celle du jeu (pompe, objets) se décode pendant que le menu est affiché.
+//
+// Les images sources sont réduites à leur taille d'affichage (au plus la boîte indiquée
+// dans la table, proportions conservées) puis rangées par étagères de hauteur décroissante.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "assets.h"
+
+#define ATLAS_LARGEUR 1024
+#define ATLAS_MARGE 2 // pixels vides autour de chaque image, contre les débordements au filtrage
+
+typedef struct
+{
+    const char *nom; // nom de la constante TextureId, recopié dans l'en-tête généré
+    const char *chemin;
+    int largeurMax;
+    int hauteurMax;
+    AtlasPage page;
+} Source;
+
+static const char *const nomsPages[ATLAS_PAGE_COUNT] = {
+    [ATLAS_PAGE_MENU] = "ATLAS_PAGE_MENU",
+    [ATLAS_PAGE_GAME] = "ATLAS_PAGE_GAME",
+};
+
+static const Source sources[] = {
+    [TEXTURE_TITLE] = {"TEXTURE_TITLE", "images/title.png", 512, 512, ATLAS_PAGE_MENU},
+    [TEXTURE_LAUNCH_BUTTON] = {"TEXTURE_LAUNCH_BUTTON", "images/launch_button.png", 400, 400, ATLAS_PAGE_MENU},
+    [TEXTURE_SCOREBOARD_BUTTON] = {"TEXTURE_SCOREBOARD_BUTTON", "images/scoreboard.png", 400, 400, ATLAS_PAGE_MENU},
+    [TEXTURE_QUIT_BUTTON] = {"TEXTURE_QUIT_BUTTON", "images/quit_button.png", 400, 400, ATLAS_PAGE_MENU},
+    [TEXTURE_RETURN] = {"TEXTURE_RETURN", "images/retour.png", 400, 400, ATLAS_PAGE_MENU},
+    [TEXTURE_POMPE] = {"TEXTURE_POMPE", "images/pompe.png", 256, 512, ATLAS_PAGE_GAME},
+    [TEXTURE_CIGARETTE] = {"TEXTURE_CIGARETTE", "images/cigarette.png", 256, 256, ATLAS_PAGE_GAME},
+    [TEXTURE_BIERE] = {"TEXTURE_BIERE", "images/biere.png", 256, 256, ATLAS_PAGE_GAME},
+    [TEXTURE_LOUPE] = {"TEXTURE_LOUPE", "images/loupe.png", 256, 256, ATLAS_PAGE_GAME},
+    [TEXTURE_PILLULES] = {"TEXTURE_PILLULES", "images/pillules.png", 256, 256, ATLAS_PAGE_GAME},
+};
+
+_Static_assert(sizeof(sources) / sizeof(sources[0]) == TEXTURE_COUNT, "une image source par TextureId");
+
+// Réduction par moyenne de zones, pondérée par l'alpha pour ne pas assombrir les bords
+static SDL_Surface *reduire(SDL_Surface *source, int largeur, int hauteur)
+{
+    SDL_Surface *resultat = SDL_CreateRGBSurfaceWithFormat(0, largeur, hauteur, 32, SDL_PIXELFORMAT_RGBA32);
+    if (resultat == NULL)
+    {
+        return NULL;
+    }
+
+    const Uint8 *src = source->pixels;
+    Uint8 *dst = resultat->pixels;
+    for (int y = 0; y < hauteur; y++)
+    {
+        int y0 = y * source->h / hauteur;
+        int y1 = (y + 1) * source->h / hauteur;
+        if (y1 <= y0)
+        {
+            y1 = y0 + 1;
+        }
+        for (int x = 0; x < largeur; x++)
+        {
+            int x0 = x * source->w / largeur;
+            int x1 = (x + 1) * source->w / largeur;
+            if (x1 <= x0)
+            {
+                x1 = x0 + 1;
+            }
+
+            uint64_t r = 0, g = 0, b = 0, a = 0;
+            for (int sy = y0; sy < y1; sy++)
+            {
+                const Uint8 *ligne = src + (size_t)sy * source->pitch;
+                for (int sx = x0; sx < x1; sx++)
+                {
+                    const Uint8 *p = ligne + sx * 4;
+                    r += (uint64_t)p[0] * p[3];
+                    g += (uint64_t)p[1] * p[3];
+                    b += (uint64_t)p[2] * p[3];
+                    a += p[3];
+                }
+            }
+
+            Uint8 *q = dst + (size_t)y * resultat->pitch + x * 4;
+            uint64_t n = (uint64_t)(x1 - x0) * (y1 - y0);
+            q[0] = a ? (Uint8)(r / a) : 0;
+            q[1] = a ? (Uint8)(g / a) : 0;
+            q[2] = a ? (Uint8)(b / a) : 0;
+            q[3] = (Uint8)(a / n);
+        }
+    }
+    return resultat;
+}
+
+static SDL_Surface *chargerReduite(const Source *source)
+{
+    SDL_Surface *chargee = IMG_Load(source->chemin);
+    if (chargee == NULL)
+    {
+        fprintf(stderr, "Impossible de charger %s : %s\n", source->chemin, IMG_GetError());
+        return NULL;
+    }
+    SDL_Surface *rgba = SDL_ConvertSurfaceFormat(chargee, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(chargee);
+    if (rgba == NULL)
+    {
+        fprintf(stderr, "Conversion de %s impossible : %s\n", source->chemin, SDL_GetError());
+        return NULL;
+    }
+
+    // Jamais agrandie : seulement réduite pour tenir dans la boîte
+    int largeur = rgba->w;
+    int hauteur = rgba->h;
+    if (largeur > source->largeurMax)
+    {
+        hauteur = hauteur * source->largeurMax / largeur;
+        largeur = source->largeurMax;
+    }
+    if (hauteur > source->hauteurMax)
+    {
+        largeur = largeur * source->hauteurMax / hauteur;
+        hauteur = source->hauteurMax;
+    }
+    if (largeur == rgba->w && hauteur == rgba->h)
+    {
+        return rgba;
+    }
+
+    SDL_Surface *reduite = reduire(rgba, largeur < 1 ? 1 : largeur, hauteur < 1 ? 1 : hauteur);
+    SDL_FreeSurface(rgba);
+    return reduite;
+}
+
+static SDL_Surface *surfaces[TEXTURE_COUNT];
+
+static int parHauteurDecroissante(const void *a, const void *b)
+{
+    int ia = *(const int *)a;
+    int ib = *(const int *)b;
+    if (surfaces[ia]->h != surfaces[ib]->h)
+    {
+        return surfaces[ib]->h - surfaces[ia]->h;
+    }
+    return ia - ib;
+}
+
+static bool ecrireEntete(const char *chemin, char *cheminsImages[ATLAS_PAGE_COUNT], const SDL_Rect rects[TEXTURE_COUNT])
+{
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL)
+    {
+        perror(chemin);
+        return false;
+    }
+
+    fprintf(f, "// Généré par Buckshot_Atlas (outil_atlas.c) à partir de images/*.png : ne pas modifier.\n");
+    fprintf(f, "#ifndef ATLAS_H\n#define ATLAS_H\n\n");
+    fprintf(f, "#include \"assets.h\"\n\n");
+    fprintf(f, "#define ATLAS_LARGEUR %d\n\n", ATLAS_LARGEUR);
+    fprintf(f, "static const char *const atlasImages[ATLAS_PAGE_COUNT] = {\n");
+    for (int p = 0; p < ATLAS_PAGE_COUNT; p++)
+    {
+        fprintf(f, "    [%s] = \"%s\",\n", nomsPages[p], cheminsImages[p]);
+    }
+    fprintf(f, "};\n\n");
+    fprintf(f, "static const AtlasPage atlasPages[TEXTURE_COUNT] = {\n");
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        fprintf(f, "    [%s] = %s,\n", sources[i].nom, nomsPages[sources[i].page]);
+    }
+    fprintf(f, "};\n\n");
+    fprintf(f, "// Rectangle de chaque image dans sa page\n");
+    fprintf(f, "static const SDL_Rect atlasRects[TEXTURE_COUNT] = {\n");
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        fprintf(f, "    [%s] = {%d, %d, %d, %d},\n", sources[i].nom, rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+    }
+    fprintf(f, "};\n\n#endif\n");
+
+    return fclose(f) == 0;
+}
+
+// Range les images de la page par étagères et écrit son PNG ; remplit leurs rectangles
+static bool construirePage(AtlasPage page, const char *chemin, SDL_Rect rects[TEXTURE_COUNT])
+{
+    int ordre[TEXTURE_COUNT];
+    int nombre = 0;
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        if (sources[i].page == page)
+        {
+            ordre[nombre++] = i;
+        }
+    }
+
+    // Rangement en étagères : les plus hautes d'abord, de gauche à droite
+    qsort(ordre, nombre, sizeof(ordre[0]), parHauteurDecroissante);
+    int x = 0, y = 0, hauteurEtagere = 0;
+    for (int k = 0; k < nombre; k++)
+    {
+        int i = ordre[k];
+        int w = surfaces[i]->w + 2 * ATLAS_MARGE;
+        int h = surfaces[i]->h + 2 * ATLAS_MARGE;
+        if (w > ATLAS_LARGEUR)
+        {
+            fprintf(stderr, "%s est trop large pour l'atlas\n", sources[i].chemin);
+            return false;
+        }
+        if (x + w > ATLAS_LARGEUR)
+        {
+            y += hauteurEtagere;
+            x = 0;
+            hauteurEtagere = 0;
+        }
+        rects[i] = (SDL_Rect){x + ATLAS_MARGE, y + ATLAS_MARGE, surfaces[i]->w, surfaces[i]->h};
+        x += w;
+        if (h > hauteurEtagere)
+        {
+            hauteurEtagere = h;
+        }
+    }
+    int hauteur = y + hauteurEtagere;
+
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_LARGEUR, hauteur, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas == NULL)
+    {
+        fprintf(stderr, "Création de l'atlas impossible : %s\n", SDL_GetError());
+        return false;
+    }
+    for (int k = 0; k < nombre; k++)
+    {
+        // Copie brute, alpha compris, dans une zone encore transparente
+        int i = ordre[k];
+        SDL_Rect destination = rects[i];
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[i], NULL, atlas, &destination);
+    }
+
+    bool ecrite = IMG_SavePNG(atlas, chemin) == 0;
+    if (ecrite)
+    {
+        printf("%d images rangées dans %s (%dx%d)\n", nombre, chemin, ATLAS_LARGEUR, hauteur);
+    }
+    else
+    {
+        fprintf(stderr, "Écriture de %s impossible : %s\n", chemin, IMG_GetError());
+    }
+    SDL_FreeSurface(atlas);
+    return ecrite;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2 + ATLAS_PAGE_COUNT)
+    {
+        fprintf(stderr, "Usage : %s <atlas_menu.png> <atlas_jeu.png> <atlas.h>\n", argv[0]);
+        return 1;
+    }
+
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+    {
+        fprintf(stderr, "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        return 1;
+    }
+
+    int code = 1;
+    SDL_Rect rects[TEXTURE_COUNT];
+
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        surfaces[i] = chargerReduite(&sources[i]);
+        if (surfaces[i] == NULL)
+        {
+            goto fin;
+        }
+    }
+
+    for (int p = 0; p < ATLAS_PAGE_COUNT; p++)
+    {
+        if (!construirePage((AtlasPage)p, argv[1 + p], rects))
+        {
+            goto fin;
+        }
+    }
+    if (!ecrireEntete(argv[1 + ATLAS_PAGE_COUNT], &argv[1], rects))
+    {
+        goto fin;
+    }
+    code = 0;
+
+fin:
+    for (int i = 0; i < TEXTURE_COUNT; i++)
+    {
+        if (surfaces[i] != NULL)
+        {
+            SDL_FreeSurface(surfaces[i]);
+        }
+    }
+    IMG_Quit();
+    return code;
+}
@@ -0,0 +1,148 @@
+// Table de décisions du dealer : écrit, pour chaque état de politique.h où le dealer a la
+// main, sa meilleure action (tir ou objet).
+//
+// Usage : Buckshot_Politique <politique_table.h>
+//
+// Les décisions sont celles de decisionIa (ia.c), sur le même modèle et avec les mêmes effets
+// d'objets (effetsObjets de regles.c) que le dealer expectimax, le joueur n'ayant pas d'objets.
+// Les vies sont écrêtées à POLITIQUE_VIE_MAX (une cigarette à vie pleine ne rapporte rien) et,
+// comme dans ia.c, les objets ne sont pas renouvelés aux recharges.
+
+#include "ia.h"
+#include "politique.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NB_CONNUES 3
+
+static uint8_t decisions[MAX_BALLES + 1][MAX_BALLES + 1][POLITIQUE_VIE_MAX][POLITIQUE_VIE_MAX][NB_CONNUES][POLITIQUE_INVENTAIRES];
+
+// Partie où le dealer a la main avec les comptes, les vies et l'inventaire donnés :
+// l'ordre des balles ne compte pas, decisionIa ne voit que les comptes et connue
+static void partieDuDealer(int rouges, int noirs, int vieOrdi, int vieJoueur, unsigned inventaire, Partie *partie)
+{
+    memset(partie, 0, sizeof(*partie));
+    partie->objets = OBJETS_VIDES;
+    partie->balles = (uint8_t)((1u << rouges) - 1);
+    partie->nombreDeBalles = (uint8_t)(rouges + noirs);
+    partie->vieOrdi = (int8_t)vieOrdi;
+    partie->vieJoueur = (int8_t)vieJoueur;
+    partie->joueurTurn = false;
+    for (int o = 0; o < NB_OBJETS; o++)
+    {
+        if (inventaire & (1u << o))
+        {
+            placerObjet(partie, o, (Object)o);
+        }
+    }
+}
+
+static bool ecrireEntete(const char *chemin)
+{
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL)
+    {
+        perror(chemin);
+        return false;
+    }
+
+    fprintf(f, "// Généré par Buckshot_Politique (outil_politique.c) : ne pas modifier.\n");
+    fprintf(f, "#ifndef POLITIQUE_TABLE_H\n#define POLITIQUE_TABLE_H\n\n");
+    fprintf(f, "#include \"politique.h\"\n\n");
+    fprintf(f, "// [rouges][noirs][vieOrdi - 1][vieJoueur - 1][connue][inventaire] : Decision\n");
+    fprintf(f, "static const uint8_t politiqueDealer[MAX_BALLES + 1][MAX_BALLES + 1][POLITIQUE_VIE_MAX][POLITIQUE_VIE_MAX][%d][POLITIQUE_INVENTAIRES] = {\n",
+            NB_CONNUES);
+    for (int r = 0; r <= MAX_BALLES; r++)
+    {
+        for (int n = 0; n <= MAX_BALLES; n++)
+        {
+            fprintf(f, "    [%d][%d] = {\n", r, n);
+            for (int vo = 0; vo < POLITIQUE_VIE_MAX; vo++)
+            {
+                fprintf(f, "        {\n");
+                for (int vj = 0; vj < POLITIQUE_VIE_MAX; vj++)
+                {
+                    fprintf(f, "            {");
+                    for (int c = 0; c < NB_CONNUES; c++)
+                    {
+                        fprintf(f, "{");
+                        for (int i = 0; i < POLITIQUE_INVENTAIRES; i++)
+                        {
+                            fprintf(f, i ? ",%d" : "%d", decisions[r][n][vo][vj][c][i]);
+                        }
+                        fprintf(f, c + 1 < NB_CONNUES ? "}, " : "}");
+                    }
+                    fprintf(f, "},\n");
+                }
+                fprintf(f, "        },\n");
+            }
+            fprintf(f, "    },\n");
+        }
+    }
+    fprintf(f, "};\n\n#endif\n");
+
+    return fclose(f) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage : %s <politique_table.h>\n", argv[0]);
+        return 1;
+    }
+
+    // Tous les états où le dealer a la main, quel que soit le chemin qui y mène
+    int compte[DECISION_OBJET + NB_OBJETS] = {0};
+    for (int r = 0; r <= MAX_BALLES; r++)
+    {
+        for (int n = 0; r + n <= MAX_BALLES; n++)
+        {
+            for (int vo = 1; vo <= POLITIQUE_VIE_MAX; vo++)
+            {
+                for (int vj = 1; vj <= POLITIQUE_VIE_MAX; vj++)
+                {
+                    for (int c = 0; c < NB_CONNUES; c++)
+                    {
+                        if (r + n == 0 || (c == ROUGE && r == 0) || (c == NOIR && n == 0))
+                        {
+                            continue;
+                        }
+                        for (unsigned inventaire = 0; inventaire < POLITIQUE_INVENTAIRES; inventaire++)
+                        {
+                            Partie partie;
+                            partieDuDealer(r, n, vo, vj, inventaire, &partie);
+                            // Sans générateur : à valeur égale, le tir sur le joueur
+                            int decision = decisionIa(&partie, c, NULL);
+                            decisions[r][n][vo - 1][vj - 1][c][inventaire] = (uint8_t)decision;
+                            compte[decision]++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    fprintf(stderr, "%zu états résolus\n", tailleTableIa());
+    libererIa();
+
+    static const char *noms[DECISION_OBJET + NB_OBJETS] = {
+        [DECISION_TIR_ADVERSAIRE] = "tir sur le joueur",
+        [DECISION_TIR_SOI] = "tir sur soi",
+        [DECISION_OBJET + CIGARETTE] = "cigarette",
+        [DECISION_OBJET + BIERRE] = "bière",
+        [DECISION_OBJET + LOUPE] = "loupe",
+        [DECISION_OBJET + PILLULES] = "pillules",
+    };
+    for (int d = 0; d < DECISION_OBJET + NB_OBJETS; d++)
+    {
+        fprintf(stderr, "%-18s %6d états\n", noms[d], compte[d]);
+    }
+
+    if (!ecrireEntete(argv[1]))
+    {
+        fprintf(stderr, "Écriture de %s impossible\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
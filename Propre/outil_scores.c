@@ -0,0 +1,70 @@
+// Outil en ligne de commande pour le stockage des scores.
+//
+// Usage : ./Buckshot_Scores importer <scores.txt>
+//         ./Buckshot_Scores top
+//         ./Buckshot_Scores joueur <nom>
+
+#include "scores.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage : %s importer <scores.txt> | top | joueur <nom>\n", argv[0]);
+        return 1;
+    }
+
+    ScoreStore store;
+    if (!scoresOuvrir(&store, SCORES_JOURNAL, SCORES_INDEX, NULL))
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s.\n", SCORES_JOURNAL);
+        return 1;
+    }
+
+    int code = 0;
+    if (strcmp(argv[1], "importer") == 0 && argc == 3)
+    {
+        long importes = scoresImporterTexte(&store, argv[2]);
+        if (importes < 0)
+        {
+            code = 1;
+        }
+        else
+        {
+            printf("%ld scores importés depuis %s.\n", importes, argv[2]);
+        }
+    }
+    else if (strcmp(argv[1], "top") == 0)
+    {
+        const ScoreEnregistrement *top;
+        int nbTop = scoresTop(&store, &top);
+        for (int i = 0; i < nbTop; i++)
+        {
+            printf("%2d. %.*s, %d\n", i + 1, SCORE_NOM_MAX - 1, top[i].nom, top[i].score);
+        }
+    }
+    else if (strcmp(argv[1], "joueur") == 0 && argc == 3)
+    {
+        const StatsJoueur *joueur = scoresJoueur(&store, argv[2]);
+        if (joueur == NULL)
+        {
+            printf("Aucun score pour %s.\n", argv[2]);
+        }
+        else
+        {
+            printf("%.*s : meilleur %d, total %lld, %u parties\n", SCORE_NOM_MAX - 1, joueur->nom, joueur->meilleur,
+                   (long long)joueur->total, joueur->parties);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Usage : %s importer <scores.txt> | top | joueur <nom>\n", argv[0]);
+        code = 1;
+    }
+
+    scoresFermer(&store);
+    return code;
+}
@@ -0,0 +1,359 @@
+// Tournoi entre politiques : chaque politique joue contre chacune des autres (et contre elle-même),
+// côté joueur puis côté dealer, avec les vraies règles en 3 manches.
+// Écrit le taux de victoire du joueur de chaque paire, avec son intervalle de confiance à 95 %,
+// en CSV sur la sortie standard.
+//
+// Usage : ./Buckshot_Tournoi [-n matchs par paire] [-t threads] [-s graine] [-p politique,politique,...] [-o]
+//
+// Les matchs sont découpés en tâches réparties entre les threads ; un thread qui n'a plus rien
+// vole des tâches au début de la file d'un autre. Chaque tâche a sa propre graine : les
+// résultats ne dépendent pas du nombre de threads.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ia.h"
+#include "politique.h"
+#include "regles.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 256
+#define MAX_POLITIQUES 8
+#define MATCHS_PAR_TACHE 4096
+#define Z_95 1.959963984540054
+
+// -o : les deux camps jouent leurs objets comme dans le jeu (jouerTour) : « table » et
+// « expectimax » les choisissent avec leur tir, les autres passent par jouerObjets
+static bool avecObjets = false;
+
+typedef struct
+{
+    const char *nom;
+    Politique politique;
+} EntreePolitique;
+
+// Nouvelle politique : l'ajouter ici, elle est aussitôt disponible pour -p
+static const EntreePolitique catalogue[] = {
+    {"heuristique", politiqueHeuristique},
+    {"adversaire", politiqueToujoursAdversaire},
+    {"seuil", politiqueSeuil},
+    {"expectimax", politiqueExpectimax},
+    {"table", politiqueTable},
+};
+#define NB_CATALOGUE ((int)(sizeof(catalogue) / sizeof(catalogue[0])))
+
+typedef struct
+{
+    int paire; // joueur * nbPolitiques + dealer
+    uint32_t matchs;
+    uint64_t graine;
+} Tache;
+
+// File de tâches d'un thread : il prend à la fin, les voleurs prennent au début
+typedef struct
+{
+    _Alignas(64) pthread_mutex_t verrou;
+    Tache *taches;
+    size_t debut;
+    size_t fin;
+    uint64_t victoires[MAX_POLITIQUES * MAX_POLITIQUES];
+    uint64_t matchs[MAX_POLITIQUES * MAX_POLITIQUES];
+    uint64_t vols;
+} Travailleur;
+
+static Travailleur *travailleurs;
+static long nbThreads;
+static const EntreePolitique *politiques[MAX_POLITIQUES];
+static int nbPolitiques;
+// Création d'un thread impossible : ceux déjà lancés s'arrêtent sans finir leurs files
+static atomic_bool abandon = false;
+
+static bool prendre(Travailleur *travailleur, Tache *tache)
+{
+    bool trouve = false;
+    pthread_mutex_lock(&travailleur->verrou);
+    if (travailleur->fin > travailleur->debut)
+    {
+        *tache = travailleur->taches[--travailleur->fin];
+        trouve = true;
+    }
+    pthread_mutex_unlock(&travailleur->verrou);
+    return trouve;
+}
+
+static bool voler(Travailleur *victime, Tache *tache)
+{
+    bool trouve = false;
+    pthread_mutex_lock(&victime->verrou);
+    if (victime->fin > victime->debut)
+    {
+        *tache = victime->taches[victime->debut++];
+        trouve = true;
+    }
+    pthread_mutex_unlock(&victime->verrou);
+    return trouve;
+}
+
+static void executer(Travailleur *travailleur, const Tache *tache)
+{
+    Politique joueur = politiques[tache->paire / nbPolitiques]->politique;
+    Politique dealer = politiques[tache->paire % nbPolitiques]->politique;
+    Alea alea;
+    aleaInit(&alea, tache->graine);
+    Partie partie;
+    ResultatMatch resultat;
+
+    uint64_t victoires = 0;
+    for (uint32_t i = 0; i < tache->matchs; i++)
+    {
+        if (avecObjets)
+        {
+            nouvellePartie(&partie, &alea);
+            victoires += finirMatchTours(&partie, joueur, dealer, &alea);
+        }
+        else
+        {
+            jouerMatch(&partie, joueur, dealer, false, &alea, &resultat);
+            victoires += resultat.joueurGagne;
+        }
+    }
+    travailleur->victoires[tache->paire] += victoires;
+    travailleur->matchs[tache->paire] += tache->matchs;
+}
+
+static void *travailler(void *arg)
+{
+    Travailleur *travailleur = arg;
+    long moi = travailleur - travailleurs;
+    Tache tache;
+
+    while (!atomic_load_explicit(&abandon, memory_order_relaxed))
+    {
+        if (prendre(travailleur, &tache))
+        {
+            executer(travailleur, &tache);
+            continue;
+        }
+        // Aucune tâche ne crée de tâche : quand toutes les files sont vides, le tournoi est fini
+        bool vole = false;
+        for (long k = 1; k < nbThreads && !vole; k++)
+        {
+            vole = voler(&travailleurs[(moi + k) % nbThreads], &tache);
+        }
+        if (!vole)
+        {
+            break;
+        }
+        travailleur->vols++;
+        executer(travailleur, &tache);
+    }
+    // Les états absents de la table partagée, résolus par ce thread
+    libererIaThread();
+    return NULL;
+}
+
+static bool choisirPolitiques(char *liste)
+{
+    nbPolitiques = 0;
+    for (char *nom = strtok(liste, ","); nom != NULL; nom = strtok(NULL, ","))
+    {
+        int p = 0;
+        while (p < NB_CATALOGUE && strcmp(catalogue[p].nom, nom) != 0)
+        {
+            p++;
+        }
+        if (p == NB_CATALOGUE)
+        {
+            fprintf(stderr, "Politique inconnue : %s\n", nom);
+            return false;
+        }
+        if (nbPolitiques == MAX_POLITIQUES)
+        {
+            fprintf(stderr, "Au plus %d politiques.\n", MAX_POLITIQUES);
+            return false;
+        }
+        politiques[nbPolitiques++] = &catalogue[p];
+    }
+    return nbPolitiques > 0;
+}
+
+// Intervalle de Wilson : reste dans [0, 1] même pour des taux proches de 0 ou 1
+static void intervalleWilson(uint64_t victoires, uint64_t matchs, double *bas, double *haut)
+{
+    if (matchs == 0)
+    {
+        *bas = 0.0;
+        *haut = 1.0;
+        return;
+    }
+    double n = (double)matchs;
+    double p = victoires / n;
+    double z2 = Z_95 * Z_95;
+    double centre = (p + z2 / (2 * n)) / (1 + z2 / n);
+    double demiLargeur = Z_95 * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+    *bas = centre - demiLargeur;
+    *haut = centre + demiLargeur;
+}
+
+int main(int argc, char *argv[])
+{
+    long long matchs = 1000000;
+    nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t graine = (uint64_t)time(NULL);
+    char listeDefaut[] = "heuristique,adversaire,seuil,expectimax,table";
+    char *liste = listeDefaut;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:p:o")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            matchs = atoll(optarg);
+            break;
+        case 't':
+            nbThreads = atol(optarg);
+            break;
+        case 's':
+            graine = strtoull(optarg, NULL, 10);
+            break;
+        case 'o':
+            avecObjets = true;
+            break;
+        case 'p':
+            liste = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage : %s [-n matchs par paire] [-t threads] [-s graine] [-p politique,politique,...] [-o]\n", argv[0]);
+            fprintf(stderr, "Politiques :");
+            for (int p = 0; p < NB_CATALOGUE; p++)
+            {
+                fprintf(stderr, " %s", catalogue[p].nom);
+            }
+            fprintf(stderr, "\n");
+            return 1;
+        }
+    }
+    if (!choisirPolitiques(liste) || matchs < 1)
+    {
+        return 1;
+    }
+    if (nbThreads < 1)
+    {
+        nbThreads = 1;
+    }
+    if (nbThreads > MAX_THREADS)
+    {
+        nbThreads = MAX_THREADS;
+    }
+
+    int nbPaires = nbPolitiques * nbPolitiques;
+    long long tachesParPaire = (matchs + MATCHS_PAR_TACHE - 1) / MATCHS_PAR_TACHE;
+    long long nbTaches = tachesParPaire * nbPaires;
+    size_t capacite = (size_t)((nbTaches + nbThreads - 1) / nbThreads);
+
+    travailleurs = aligned_alloc(64, sizeof(Travailleur) * nbThreads);
+    Tache *taches = malloc(sizeof(Tache) * capacite * nbThreads);
+    if (travailleurs == NULL || taches == NULL)
+    {
+        fprintf(stderr, "Erreur d'allocation des files de tâches.\n");
+        return 1;
+    }
+    for (long t = 0; t < nbThreads; t++)
+    {
+        memset(&travailleurs[t], 0, sizeof(Travailleur));
+        pthread_mutex_init(&travailleurs[t].verrou, NULL);
+        travailleurs[t].taches = taches + t * capacite;
+    }
+
+    // Distribution tournante : chaque file reçoit un peu de chaque paire, les vols équilibrent le reste
+    for (long long k = 0; k < nbTaches; k++)
+    {
+        int paire = (int)(k % nbPaires);
+        long long rang = k / nbPaires;
+        long long restants = matchs - rang * MATCHS_PAR_TACHE;
+        Travailleur *travailleur = &travailleurs[k % nbThreads];
+        travailleur->taches[travailleur->fin++] = (Tache){
+            .paire = paire,
+            .matchs = (uint32_t)(restants < MATCHS_PAR_TACHE ? restants : MATCHS_PAR_TACHE),
+            .graine = graine + (uint64_t)k,
+        };
+    }
+
+    // Une seule table expectimax, résolue ici puis lue par tous les threads
+    for (int p = 0; p < nbPolitiques; p++)
+    {
+        if (politiques[p]->politique == politiqueExpectimax)
+        {
+            prechaufferIa();
+            break;
+        }
+    }
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    pthread_t threads[MAX_THREADS];
+    for (long t = 0; t < nbThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, travailler, &travailleurs[t]) != 0)
+        {
+            fprintf(stderr, "Impossible de créer le thread %ld.\n", t);
+            atomic_store_explicit(&abandon, true, memory_order_relaxed);
+            for (long u = 0; u < t; u++)
+            {
+                pthread_join(threads[u], NULL);
+            }
+            libererIa();
+            return 1;
+        }
+    }
+
+    uint64_t victoires[MAX_POLITIQUES * MAX_POLITIQUES] = {0};
+    uint64_t joues[MAX_POLITIQUES * MAX_POLITIQUES] = {0};
+    uint64_t vols = 0;
+    for (long t = 0; t < nbThreads; t++)
+    {
+        pthread_join(threads[t], NULL);
+        for (int p = 0; p < nbPaires; p++)
+        {
+            victoires[p] += travailleurs[t].victoires[p];
+            joues[p] += travailleurs[t].matchs[p];
+        }
+        vols += travailleurs[t].vols;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double duree = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+
+    printf("joueur,dealer,matchs,victoires_joueur,taux_victoire_joueur,ic95_bas,ic95_haut\n");
+    uint64_t total = 0;
+    for (int p = 0; p < nbPaires; p++)
+    {
+        double bas, haut;
+        intervalleWilson(victoires[p], joues[p], &bas, &haut);
+        printf("%s,%s,%llu,%llu,%.6f,%.6f,%.6f\n", politiques[p / nbPolitiques]->nom, politiques[p % nbPolitiques]->nom,
+               (unsigned long long)joues[p], (unsigned long long)victoires[p],
+               joues[p] ? (double)victoires[p] / joues[p] : 0.0, bas, haut);
+        total += joues[p];
+    }
+    fprintf(stderr, "%llu matchs en %.3f s sur %ld threads (%.0f matchs/s), %llu tâches volées, graine %llu\n",
+            (unsigned long long)total, duree, nbThreads, duree > 0 ? total / duree : 0.0,
+            (unsigned long long)vols, (unsigned long long)graine);
+
+    for (long t = 0; t < nbThreads; t++)
+    {
+        pthread_mutex_destroy(&travailleurs[t].verrou);
+    }
+    free(taches);
+    free(travailleurs);
+    libererIa();
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "politique.h"
+#include "ia.h"
+#include "politique_table.h"
+
+static inline int ecreterVie(int vie)
+{
+    return vie > POLITIQUE_VIE_MAX ? POLITIQUE_VIE_MAX : (vie < 1 ? 1 : vie);
+}
+
+// Bit o : le camp au trait possède au moins un objet de type o
+static inline unsigned inventaireCamp(const Partie *partie)
+{
+    int premier = partie->joueurTurn ? PREMIER_EMPLACEMENT_JOUEUR : 0;
+    unsigned inventaire = 0;
+    for (int i = premier; i < premier + EMPLACEMENTS_PAR_CAMP; i++)
+    {
+        Object objet = objetEn(partie, i);
+        if (objet < NB_OBJETS)
+        {
+            inventaire |= 1u << objet;
+        }
+    }
+    return inventaire;
+}
+
+int decisionTable(const Partie *partie, int connue, Alea *alea)
+{
+    (void)alea;
+    int vie = partie->joueurTurn ? partie->vieJoueur : partie->vieOrdi;
+    int vieAdversaire = partie->joueurTurn ? partie->vieOrdi : partie->vieJoueur;
+    return politiqueDealer[nombreRouges(partie)][nombreNoirs(partie)][ecreterVie(vie) - 1]
+                          [ecreterVie(vieAdversaire) - 1][connue][inventaireCamp(partie)];
+}
+
+bool jouerObjetsTable(Partie *partie, Alea *alea, Cible *cible)
+{
+    return jouerObjetsDecides(partie, decisionTable, alea, cible);
+}
+
+Cible politiqueTable(const Partie *partie, Alea *alea)
+{
+    (void)alea;
+    if (partie->nombreDeBalles == 0)
+    {
+        return CIBLE_ADVERSAIRE;
+    }
+    Partie sansObjets = *partie;
+    sansObjets.objets = OBJETS_VIDES;
+    return (Cible)decisionTable(&sansObjets, BALLE_INCONNUE, alea);
+}
+
+bool jouerTour(Partie *partie, Politique politique, Alea *alea, Cible *cible)
+{
+    if (politique == politiqueTable)
+    {
+        return jouerObjetsTable(partie, alea, cible);
+    }
+    if (politique == politiqueExpectimax)
+    {
+        return jouerObjetsExpectimax(partie, alea, cible);
+    }
+    if (!jouerObjets(partie, alea, cible))
+    {
+        *cible = politique(partie, alea);
+    }
+    return true;
+}
+
+bool finirMatchTours(Partie *partie, Politique joueur, Politique ordi, Alea *alea)
+{
+    for (;;)
+    {
+        while (!mancheTerminee(partie))
+        {
+            Cible cible;
+            if (jouerTour(partie, partie->joueurTurn ? joueur : ordi, alea, &cible))
+            {
+                tirer(partie, cible);
+            }
+            rechargerSiVide(partie, alea);
+        }
+        if (partie->vieJoueur <= 0)
+        {
+            return false;
+        }
+        if (partie->manche >= NB_MANCHES)
+        {
+            return true;
+        }
+        partie->manche++;
+        debuterManche(partie, alea);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef POLITIQUE_H
+#define POLITIQUE_H
+
+// Dealer qui joue ses objets d'après une table de décisions calculée hors ligne
+// (« make politique » : outil_politique.c résout l'espace d'états et écrit politique_table.h).
+// En jeu, chaque décision est une seule lecture dans la table : aucune recherche.
+//
+// État de la table, vu par le dealer au moment de jouer : comptes de balles, vies
+// (écrêtées à POLITIQUE_VIE_MAX), balle courante révélée ou non par une loupe, et
+// présence de chaque objet dans ses emplacements. Les objets du joueur n'y figurent pas.
+// Le camp du joueur peut aussi la lire (tournoi) : ses vies et ses objets prennent alors
+// la place de ceux du dealer.
+
+#include "regles.h"
+
+#include <stdint.h>
+
+#define POLITIQUE_VIE_MAX 6   // vie de départ la plus haute ; au-delà, la vie est écrêtée
+#define POLITIQUE_INVENTAIRES (1 << NB_OBJETS) // un bit de présence par type d'objet
+
+_Static_assert(DECISION_OBJET + NB_OBJETS <= UINT8_MAX, "une décision tient dans un octet");
+
+// Décision de la table pour le camp au trait (le chargeur n'est pas vide) : un Decideur
+int decisionTable(const Partie *partie, int connue, Alea *alea);
+
+// Joue les objets du camp au trait dans l'ordre de la table : jouerObjetsDecides avec decisionTable
+bool jouerObjetsTable(Partie *partie, Alea *alea, Cible *cible);
+
+// Choix du tir seul, sans objets, pour les simulations (politique du dealer « table »)
+Cible politiqueTable(const Partie *partie, Alea *alea);
+
+// Tour du camp au trait avec sa politique, comme le joue le jeu : les dealers « table » et
+// « expectimax » choisissent leurs objets avec leur tir, les autres politiques passent
+// d'abord par jouerObjets. Même contrat que jouerObjetsDecides.
+bool jouerTour(Partie *partie, Politique politique, Alea *alea, Cible *cible);
+
+// Joue la fin d'un match commencé (manches suivantes comprises), chaque camp jouant ses tours
+// par jouerTour ; retourne true si le joueur gagne
+bool finirMatchTours(Partie *partie, Politique joueur, Politique ordi, Alea *alea);
+
+#endif
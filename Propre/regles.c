@@ -0,0 +1,386 @@
+#include "regles.h"
+
+#include <string.h>
+
+void aleaInit(Alea *alea, uint64_t graine)
+{
+    // splitmix64 pour remplir l'état : jamais nul, et des graines voisines donnent des états sans rapport
+    uint64_t x = graine;
+    for (int i = 0; i < 4; i++)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        alea->s[i] = z ^ (z >> 31);
+    }
+}
+
+void aleaSaut(Alea *alea)
+{
+    // Polynôme de saut de xoshiro256** : équivaut à 2^128 appels à aleaSuivant
+    static const uint64_t SAUT[4] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                     0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int b = 0; b < 64; b++)
+        {
+            if (SAUT[i] & (1ULL << b))
+            {
+                for (int k = 0; k < 4; k++)
+                {
+                    s[k] ^= alea->s[k];
+                }
+            }
+            aleaSuivant(alea);
+        }
+    }
+    memcpy(alea->s, s, sizeof(s));
+}
+
+void nouvellePartie(Partie *partie, Alea *alea)
+{
+    memset(partie, 0, sizeof(*partie));
+    partie->objets = OBJETS_VIDES;
+    partie->manche = 1;
+    debuterManche(partie, alea);
+}
+
+void debuterManche(Partie *partie, Alea *alea)
+{
+    if (partie->vieJoueur <= 0 || partie->vieOrdi <= 0)
+    {
+        partie->vieJoueur = 3 + aleaBorne(alea, 4); // Vie du joueur entre 3 et 6
+        partie->vieOrdi = partie->vieJoueur;
+    }
+    partie->joueurTurn = true;
+    genererBalles(partie, alea);
+    distribuerObjets(partie, alea);
+}
+
+void genererBalles(Partie *partie, Alea *alea)
+{
+    int nombreDeBalles = aleaBorne(alea, 7) + 2;
+    unsigned masque = (1u << nombreDeBalles) - 1;
+    unsigned balles = (unsigned)aleaSuivant(alea) & masque;
+
+    // Au moins une balle de chaque couleur : on force la dernière si besoin
+    if (balles == 0)
+    {
+        balles = 1u << (nombreDeBalles - 1);
+    }
+    else if (balles == masque)
+    {
+        balles &= ~(1u << (nombreDeBalles - 1));
+    }
+
+    partie->balles = (uint8_t)balles;
+    partie->nombreDeBalles = (uint8_t)nombreDeBalles;
+    partie->balleVue = false;
+}
+
+// Place nombreObjets objets aléatoires dans des cases distinctes d'un camp
+static void placerObjets(Partie *partie, int premier, int nombreObjets, Alea *alea)
+{
+    int casesVides[EMPLACEMENTS_PAR_CAMP];
+    int nbVides = EMPLACEMENTS_PAR_CAMP;
+    for (int i = 0; i < EMPLACEMENTS_PAR_CAMP; i++)
+    {
+        casesVides[i] = premier + i;
+    }
+
+    for (int i = 0; i < nombreObjets && nbVides > 0; i++)
+    {
+        int index = aleaBorne(alea, nbVides);
+        int emplacement = casesVides[index];
+        // Déplacer la dernière case vide à la place de celle utilisée
+        casesVides[index] = casesVides[--nbVides];
+        placerObjet(partie, emplacement, (Object)aleaBorne(alea, NB_OBJETS));
+    }
+}
+
+void distribuerObjets(Partie *partie, Alea *alea)
+{
+    // Même nombre d'objets (entre 1 et 4) pour l'ordinateur et le joueur
+    int nombreObjets = aleaBorne(alea, 4) + 1;
+    placerObjets(partie, 0, nombreObjets, alea);
+    placerObjets(partie, PREMIER_EMPLACEMENT_JOUEUR, nombreObjets, alea);
+}
+
+void rechargerSiVide(Partie *partie, Alea *alea)
+{
+    if (partie->nombreDeBalles == 0)
+    {
+        genererBalles(partie, alea);
+        distribuerObjets(partie, alea);
+    }
+}
+
+static int retirerBalle(Partie *partie)
+{
+    int balle = balleEn(partie, 0);
+    partie->balles >>= 1;
+    partie->nombreDeBalles--;
+    partie->balleVue = false;
+    return balle;
+}
+
+int tirer(Partie *partie, Cible cible)
+{
+    bool tireurJoueur = partie->joueurTurn;
+    int balle = retirerBalle(partie);
+
+    if (balle == ROUGE)
+    {
+        if ((cible == CIBLE_SOI) == tireurJoueur)
+        {
+            partie->vieJoueur--;
+        }
+        else
+        {
+            partie->vieOrdi--;
+        }
+        partie->joueurTurn = !tireurJoueur;
+    }
+    else if (cible == CIBLE_ADVERSAIRE)
+    {
+        partie->joueurTurn = !tireurJoueur;
+    }
+    // Balle noire tirée sur soi-même : le tireur rejoue
+
+    return balle;
+}
+
+static void effetCigarette(Partie *partie, int8_t *vie, int issue)
+{
+    (void)partie;
+    (void)issue;
+    (*vie)++;
+}
+
+// Passe à la balle suivante sans tirer
+static void effetBiere(Partie *partie, int8_t *vie, int issue)
+{
+    (void)vie;
+    (void)issue;
+    if (partie->nombreDeBalles > 0)
+    {
+        retirerBalle(partie);
+    }
+}
+
+// Ne change rien à l'état : l'appelant révèle la balle courante
+static void effetLoupe(Partie *partie, int8_t *vie, int issue)
+{
+    (void)partie;
+    (void)vie;
+    (void)issue;
+}
+
+// Issue 0 : deux vies perdues, issue 1 : deux vies gagnées
+static void effetPillules(Partie *partie, int8_t *vie, int issue)
+{
+    (void)partie;
+    *vie += issue == 0 ? -2 : 2;
+}
+
+const EffetObjet effetsObjets[NB_OBJETS] = {
+    [CIGARETTE] = {"une cigarette", effetCigarette, 1, false},
+    [BIERRE] = {"une bière", effetBiere, 1, false},
+    [LOUPE] = {"une loupe", effetLoupe, 1, true},
+    [PILLULES] = {"des pillules", effetPillules, 2, false},
+};
+
+Object utiliserObjet(Partie *partie, int emplacement, Alea *alea)
+{
+    Object objet = objetEn(partie, emplacement);
+    if (objet >= NB_OBJETS)
+    {
+        return Null;
+    }
+    const EffetObjet *effet = &effetsObjets[objet];
+    bool joueur = emplacement >= PREMIER_EMPLACEMENT_JOUEUR;
+    int issue = effet->issues > 1 ? aleaBorne(alea, effet->issues) : 0;
+    effet->appliquer(partie, joueur ? &partie->vieJoueur : &partie->vieOrdi, issue);
+    if (effet->revele && joueur && partie->nombreDeBalles > 0)
+    {
+        partie->balleVue = true;
+    }
+    placerObjet(partie, emplacement, Null);
+    return objet;
+}
+
+// Vrai si l'un des 8 emplacements d'un camp (8 quartets) contient l'objet
+static inline bool campPossede(uint32_t camp, Object objet)
+{
+    uint32_t x = camp ^ (0x11111111u * objet); // quartet nul là où se trouve l'objet
+    return ((x - 0x11111111u) & ~x & 0x88888888u) != 0;
+}
+
+bool jouerObjets(Partie *partie, Alea *alea, Cible *cible)
+{
+    int premier = partie->joueurTurn ? PREMIER_EMPLACEMENT_JOUEUR : 0;
+    uint32_t camp = (uint32_t)(partie->objets >> (4 * premier));
+    // Cas le plus courant dans les simulations : rien d'utile, aucun emplacement à parcourir
+    if (!campPossede(camp, CIGARETTE) && !campPossede(camp, LOUPE))
+    {
+        return false;
+    }
+
+    int loupe = -1;
+    for (int i = premier; i < premier + EMPLACEMENTS_PAR_CAMP; i++)
+    {
+        Object objet = objetEn(partie, i);
+        if (objet == CIGARETTE)
+        {
+            utiliserObjet(partie, i, alea);
+        }
+        else if (objet == LOUPE && loupe < 0)
+        {
+            loupe = i;
+        }
+    }
+
+    if (loupe < 0 || partie->nombreDeBalles == 0)
+    {
+        return false;
+    }
+    utiliserObjet(partie, loupe, alea);
+    // Balle noire sur soi-même : le tour continue
+    *cible = balleEn(partie, 0) == ROUGE ? CIBLE_ADVERSAIRE : CIBLE_SOI;
+    return true;
+}
+
+static int emplacementDuCamp(const Partie *partie, Object objet)
+{
+    int premier = partie->joueurTurn ? PREMIER_EMPLACEMENT_JOUEUR : 0;
+    for (int i = premier; i < premier + EMPLACEMENTS_PAR_CAMP; i++)
+    {
+        if (objetEn(partie, i) == objet)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool jouerObjetsDecides(Partie *partie, Decideur decider, Alea *alea, Cible *cible)
+{
+    int connue = BALLE_INCONNUE;
+    // Chaque objet utilisé quitte l'inventaire : au plus un objet par emplacement, puis le tir
+    for (int tours = 0; tours <= EMPLACEMENTS_PAR_CAMP; tours++)
+    {
+        if (partie->nombreDeBalles == 0 || mancheTerminee(partie))
+        {
+            return false;
+        }
+        int decision = decider(partie, connue, alea);
+        if (decision < DECISION_OBJET)
+        {
+            *cible = (Cible)decision;
+            return true;
+        }
+        Object objet = (Object)(decision - DECISION_OBJET);
+        int emplacement = emplacementDuCamp(partie, objet);
+        if (emplacement < 0)
+        {
+            break;
+        }
+        int balles = partie->nombreDeBalles;
+        utiliserObjet(partie, emplacement, alea);
+        if (effetsObjets[objet].revele)
+        {
+            connue = balleEn(partie, 0);
+        }
+        else if (partie->nombreDeBalles != balles)
+        {
+            connue = BALLE_INCONNUE;
+        }
+    }
+    // Un décideur ne propose que des objets présents : ne devrait jamais arriver
+    *cible = CIBLE_ADVERSAIRE;
+    return partie->nombreDeBalles > 0 && !mancheTerminee(partie);
+}
+
+bool mancheTerminee(const Partie *partie)
+{
+    return partie->vieJoueur <= 0 || partie->vieOrdi <= 0;
+}
+
+Cible politiqueHeuristique(const Partie *partie, Alea *alea)
+{
+    int rouges = nombreRouges(partie);
+    int noirs = nombreNoirs(partie);
+
+    // Plus de balles rouges que de noires : attaquer l'adversaire
+    if (rouges > noirs)
+    {
+        return CIBLE_ADVERSAIRE;
+    }
+    // Plus de balles noires que de rouges : tirer sur soi-même
+    if (noirs > rouges)
+    {
+        return CIBLE_SOI;
+    }
+    // Égalité : légère préférence pour tirer sur l'adversaire
+    return aleaBorne(alea, 3) == 0 ? CIBLE_SOI : CIBLE_ADVERSAIRE;
+}
+
+Cible politiqueToujoursAdversaire(const Partie *partie, Alea *alea)
+{
+    (void)partie;
+    (void)alea;
+    return CIBLE_ADVERSAIRE;
+}
+
+Cible politiqueSeuil(const Partie *partie, Alea *alea)
+{
+    (void)alea;
+    if (partie->nombreDeBalles == 0)
+    {
+        return CIBLE_ADVERSAIRE;
+    }
+    double probabiliteRouge = (double)nombreRouges(partie) / partie->nombreDeBalles;
+    return probabiliteRouge >= SEUIL_ROUGE ? CIBLE_ADVERSAIRE : CIBLE_SOI;
+}
+
+static Cible choisirCible(Partie *partie, Politique joueur, Politique ordi, bool avecObjets, Alea *alea)
+{
+    Cible cible;
+    if (avecObjets && jouerObjets(partie, alea, &cible))
+    {
+        return cible;
+    }
+    Politique politique = partie->joueurTurn ? joueur : ordi;
+    return politique(partie, alea);
+}
+
+void jouerMatch(Partie *partie, Politique joueur, Politique ordi, bool avecObjets, Alea *alea, ResultatMatch *resultat)
+{
+    memset(resultat, 0, sizeof(*resultat));
+    nouvellePartie(partie, alea);
+
+    while (partie->manche <= NB_MANCHES)
+    {
+        int tirs = 0;
+        while (!mancheTerminee(partie))
+        {
+            tirer(partie, choisirCible(partie, joueur, ordi, avecObjets, alea));
+            rechargerSiVide(partie, alea);
+            tirs++;
+        }
+
+        resultat->tirs[partie->manche - 1] = tirs;
+        resultat->manchesJouees = partie->manche;
+        if (partie->vieJoueur <= 0)
+        {
+            return;
+        }
+        if (++partie->manche <= NB_MANCHES)
+        {
+            debuterManche(partie, alea);
+        }
+    }
+
+    resultat->joueurGagne = true;
+}
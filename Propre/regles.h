@@ -0,0 +1,196 @@
+#ifndef REGLES_H
+#define REGLES_H
+
+// Cœur des règles du jeu, sans aucune dépendance à SDL.
+// Utilisé à la fois par le jeu (main.c) et par le simulateur (simulation.c).
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ROUGE 0
+#define NOIR 1
+
+#define MAX_BALLES 8
+#define NB_MANCHES 3
+
+// Les 16 cases d'objets des sous-grilles (ids 6 à 21).
+// Emplacements 0 à 7 : ordinateur (sous-grilles 0 et 1), 8 à 15 : joueur (sous-grilles 2 et 3).
+#define NB_EMPLACEMENTS 16
+#define EMPLACEMENTS_PAR_CAMP 8
+#define PREMIER_EMPLACEMENT_JOUEUR 8
+
+typedef enum
+{
+    CIGARETTE,
+    BIERRE,
+    LOUPE,
+    PILLULES,
+    Null
+} Object;
+
+// Nombre de types d'objets : Null suit toujours le dernier
+#define NB_OBJETS Null
+
+typedef enum
+{
+    CIBLE_ADVERSAIRE,
+    CIBLE_SOI
+} Cible;
+
+// Valeur de connue quand le camp au trait ne sait pas la couleur de la balle courante
+#define BALLE_INCONNUE 2
+
+// Ce que décide un camp à son tour : tirer (valeurs de Cible) ou utiliser un objet (DECISION_OBJET + Object)
+typedef enum
+{
+    DECISION_TIR_ADVERSAIRE = CIBLE_ADVERSAIRE,
+    DECISION_TIR_SOI = CIBLE_SOI,
+    DECISION_OBJET
+} Decision;
+
+// Générateur pseudo-aléatoire propre à chaque partie (xoshiro256**), semé une fois par match.
+// Tous les tirages des règles passent par lui ; aleaSaut avance de 2^128 tirages,
+// ce qui découpe une même graine en flux indépendants (un par thread du simulateur).
+typedef struct
+{
+    uint64_t s[4];
+} Alea;
+
+// État complet d'une partie : POD de 16 octets, copiable et hachable tel quel.
+// Le chargeur est un masque de bits : bit i = 1 si la i-ème balle restante est rouge,
+// le bit 0 étant la balle courante. Les bits au-delà de nombreDeBalles sont toujours nuls.
+typedef struct
+{
+    uint64_t objets; // 16 emplacements de 4 bits contenant un Object
+    uint8_t balles;
+    uint8_t nombreDeBalles;
+    int8_t vieJoueur;
+    int8_t vieOrdi;
+    uint8_t manche;
+    bool joueurTurn;
+    bool balleVue;   // la loupe du joueur a révélé la balle courante (effacé quand elle part)
+    uint8_t reserve; // toujours à zéro, pour comparer et hacher l'état octet par octet
+} Partie;
+
+_Static_assert(sizeof(Partie) == 16, "Partie doit tenir dans 16 octets");
+
+// Tous les emplacements à Null
+#define OBJETS_VIDES (0x1111111111111111ULL * Null)
+
+_Static_assert(NB_OBJETS < 16, "un objet tient dans 4 bits");
+
+// Effet d'un objet sur la partie ; vie est celle du camp qui l'utilise.
+// Un effet aléatoire a plusieurs issues équiprobables : utiliserObjet en tire une,
+// ia.c les parcourt toutes. L'effet lui-même est déterministe une fois l'issue donnée.
+// Ajouter un objet : une valeur dans Object et une ligne dans effetsObjets (regles.c).
+typedef struct
+{
+    const char *nom;  // pour le récit : "une cigarette"
+    void (*appliquer)(Partie *partie, int8_t *vie, int issue);
+    int issues;       // nombre d'issues équiprobables, 1 pour un effet certain
+    bool revele;      // montre la balle courante à celui qui l'utilise
+} EffetObjet;
+
+extern const EffetObjet effetsObjets[NB_OBJETS];
+
+typedef struct
+{
+    bool joueurGagne;
+    int manchesJouees;
+    int tirs[NB_MANCHES];
+} ResultatMatch;
+
+// Choix de la cible pour le camp dont c'est le tour.
+typedef Cible (*Politique)(const Partie *partie, Alea *alea);
+
+// Décision du camp dont c'est le tour ; connue : ROUGE, NOIR ou BALLE_INCONNUE
+typedef int (*Decideur)(const Partie *partie, int connue, Alea *alea);
+
+void aleaInit(Alea *alea, uint64_t graine);
+void aleaSaut(Alea *alea);
+
+static inline uint64_t aleaRotation(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t aleaSuivant(Alea *alea)
+{
+    uint64_t *s = alea->s;
+    uint64_t resultat = aleaRotation(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = aleaRotation(s[3], 45);
+    return resultat;
+}
+
+// Entier uniforme dans [0, borne[
+static inline int aleaBorne(Alea *alea, int borne)
+{
+    return (int)(((aleaSuivant(alea) >> 32) * (uint64_t)borne) >> 32);
+}
+
+static inline int nombreRouges(const Partie *partie)
+{
+    return __builtin_popcount(partie->balles);
+}
+
+static inline int nombreNoirs(const Partie *partie)
+{
+    return partie->nombreDeBalles - nombreRouges(partie);
+}
+
+// Couleur (ROUGE ou NOIR) de la i-ème balle restante, 0 étant la balle courante
+static inline int balleEn(const Partie *partie, int i)
+{
+    return (partie->balles >> i) & 1 ? ROUGE : NOIR;
+}
+
+static inline Object objetEn(const Partie *partie, int emplacement)
+{
+    return (Object)((partie->objets >> (4 * emplacement)) & 0xF);
+}
+
+static inline void placerObjet(Partie *partie, int emplacement, Object objet)
+{
+    partie->objets = (partie->objets & ~(0xFULL << (4 * emplacement))) | ((uint64_t)objet << (4 * emplacement));
+}
+
+void nouvellePartie(Partie *partie, Alea *alea);
+void debuterManche(Partie *partie, Alea *alea);
+void genererBalles(Partie *partie, Alea *alea);
+void distribuerObjets(Partie *partie, Alea *alea);
+void rechargerSiVide(Partie *partie, Alea *alea);
+int tirer(Partie *partie, Cible cible);
+
+// Applique l'effet de l'objet de l'emplacement et le retire ; le même code sert au joueur,
+// au dealer et aux simulations
+Object utiliserObjet(Partie *partie, int emplacement, Alea *alea);
+bool mancheTerminee(const Partie *partie);
+
+// Le camp au trait utilise ses objets avant de tirer : toutes ses cigarettes, puis une loupe.
+// Retourne true si la balle courante est alors connue, avec la cible qui en découle dans *cible.
+bool jouerObjets(Partie *partie, Alea *alea, Cible *cible);
+
+// Le camp au trait utilise les objets que choisit decider, jusqu'à ce qu'il décide d'un tir.
+// Retourne true avec la cible dans *cible ; false s'il ne reste rien à tirer (chargeur vidé
+// par une bière, manche finie par des pillules).
+bool jouerObjetsDecides(Partie *partie, Decideur decider, Alea *alea, Cible *cible);
+
+Cible politiqueHeuristique(const Partie *partie, Alea *alea);
+
+// Tire toujours sur l'adversaire
+Cible politiqueToujoursAdversaire(const Partie *partie, Alea *alea);
+
+// Tire sur l'adversaire dès que la probabilité d'une balle rouge atteint SEUIL_ROUGE
+#define SEUIL_ROUGE 0.5
+Cible politiqueSeuil(const Partie *partie, Alea *alea);
+
+// avecObjets : les deux camps passent par jouerObjets avant chaque tir
+void jouerMatch(Partie *partie, Politique joueur, Politique ordi, bool avecObjets, Alea *alea, ResultatMatch *resultat);
+
+#endif
@@ -0,0 +1,112 @@
+#include "replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void replayCommencer(Replay *replay, uint64_t graine, Dealer dealer)
+{
+    memset(replay, 0, sizeof(*replay));
+    memcpy(replay->entete.magie, REPLAY_MAGIE, sizeof(replay->entete.magie));
+    replay->entete.version = REPLAY_VERSION;
+    replay->entete.dealer = (uint8_t)dealer;
+    replay->entete.graine = graine;
+}
+
+bool replayAjouter(Replay *replay, int idCase)
+{
+    if (idCase < 0 || idCase > UINT8_MAX)
+    {
+        return false;
+    }
+    if (replay->entete.nbCases == replay->capacite)
+    {
+        size_t capacite = replay->capacite ? replay->capacite * 2 : 64;
+        uint8_t *cases = realloc(replay->cases, capacite);
+        if (cases == NULL)
+        {
+            return false;
+        }
+        replay->cases = cases;
+        replay->capacite = capacite;
+    }
+    replay->cases[replay->entete.nbCases++] = (uint8_t)idCase;
+    return true;
+}
+
+void replayTerminer(Replay *replay, const Jeu *jeu)
+{
+    replay->entete.fin = jeu->partie;
+    replay->entete.etatFinal = (uint8_t)jeu->etat;
+}
+
+bool replayEcrire(const Replay *replay, const char *chemin)
+{
+    FILE *fichier = fopen(chemin, "wb");
+    if (fichier == NULL)
+    {
+        perror(chemin);
+        return false;
+    }
+
+    bool ok = fwrite(&replay->entete, sizeof(replay->entete), 1, fichier) == 1 &&
+              fwrite(replay->cases, 1, replay->entete.nbCases, fichier) == replay->entete.nbCases;
+    if (fclose(fichier) != 0)
+    {
+        ok = false;
+    }
+    return ok;
+}
+
+bool replayLire(Replay *replay, const char *chemin)
+{
+    memset(replay, 0, sizeof(*replay));
+    FILE *fichier = fopen(chemin, "rb");
+    if (fichier == NULL)
+    {
+        perror(chemin);
+        return false;
+    }
+
+    bool ok = fread(&replay->entete, sizeof(replay->entete), 1, fichier) == 1 &&
+              memcmp(replay->entete.magie, REPLAY_MAGIE, sizeof(replay->entete.magie)) == 0 &&
+              replay->entete.version == REPLAY_VERSION;
+    if (ok && replay->entete.nbCases > 0)
+    {
+        replay->cases = malloc(replay->entete.nbCases);
+        replay->capacite = replay->entete.nbCases;
+        ok = replay->cases != NULL &&
+             fread(replay->cases, 1, replay->entete.nbCases, fichier) == replay->entete.nbCases;
+    }
+    fclose(fichier);
+
+    if (!ok)
+    {
+        fprintf(stderr, "%s : replay invalide ou tronqué\n", chemin);
+        replayLiberer(replay);
+    }
+    return ok;
+}
+
+void replayLiberer(Replay *replay)
+{
+    free(replay->cases);
+    replay->cases = NULL;
+    replay->capacite = 0;
+    replay->entete.nbCases = 0;
+}
+
+bool replayConforme(const Replay *replay, const Jeu *jeu)
+{
+    return jeu->etat == replay->entete.etatFinal &&
+           memcmp(&jeu->partie, &replay->entete.fin, sizeof(jeu->partie)) == 0;
+}
+
+bool replayVerifier(const Replay *replay, Jeu *jeu)
+{
+    for (uint32_t i = 0; i < replay->entete.nbCases; i++)
+    {
+        jeuCliquer(jeu, replay->cases[i]);
+    }
+    return replayConforme(replay, jeu);
+}
@@ -0,0 +1,63 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Replays binaires compacts : la graine de la partie, le dealer utilisé et la suite des
+// cases cliquées (un octet par clic). L'état final enregistré permet de vérifier qu'une
+// relecture par le code actuel des règles aboutit exactement au même résultat.
+
+#include "jeu.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define REPLAY_MAGIE "BSRP"
+#define REPLAY_VERSION 2 // 2 : le dealer utilise ses objets, les replays de la version 1 ne se rejouent plus
+#define REPLAY_EXTENSION ".rpl"
+
+typedef enum
+{
+    DEALER_HEURISTIQUE,
+    DEALER_EXPECTIMAX,
+    DEALER_TABLE, // objets et tirs lus dans la table de politique.h
+    NB_DEALERS
+} Dealer;
+
+// En-tête du fichier, suivi de nbCases octets (ids des cases cliquées)
+typedef struct
+{
+    char magie[4];
+    uint8_t version;
+    uint8_t dealer;    // Dealer
+    uint8_t etatFinal; // EtatJeu à la fin de l'enregistrement
+    uint8_t reserve;
+    uint64_t graine;
+    uint32_t nbCases;
+    uint32_t reserve2;
+    Partie fin; // état de la partie à la fin de l'enregistrement
+} EnteteReplay;
+
+_Static_assert(sizeof(EnteteReplay) == 40, "l'en-tête d'un replay fait 40 octets");
+
+typedef struct
+{
+    EnteteReplay entete;
+    uint8_t *cases;
+    size_t capacite;
+} Replay;
+
+void replayCommencer(Replay *replay, uint64_t graine, Dealer dealer);
+bool replayAjouter(Replay *replay, int idCase);
+void replayTerminer(Replay *replay, const Jeu *jeu);
+bool replayEcrire(const Replay *replay, const char *chemin);
+bool replayLire(Replay *replay, const char *chemin);
+void replayLiberer(Replay *replay);
+
+// true si jeu est dans l'état final enregistré
+bool replayConforme(const Replay *replay, const Jeu *jeu);
+
+// Rejoue toutes les cases dans jeu (déjà démarré avec la graine du replay) puis le compare
+// à l'état final enregistré
+bool replayVerifier(const Replay *replay, Jeu *jeu);
+
+#endif
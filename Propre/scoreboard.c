@@ -0,0 +1,203 @@
+#include "scoreboard.h"
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SCOREBOARD_SCROLLBAR_WIDTH 6
+
+_Static_assert(SCOREBOARD_POOL >= 2, "au moins deux textures de lignes");
+
+bool scoreboardInit(Scoreboard *board, const ScoreStore *store, TTF_Font *font, SDL_Rect view, int lineHeight)
+{
+    memset(board, 0, sizeof(*board));
+    board->store = store;
+    board->font = font;
+    board->view = view;
+    board->lineHeight = lineHeight;
+    board->visibleRows = view.h / lineHeight;
+    if (board->visibleRows > SCOREBOARD_POOL)
+    {
+        board->visibleRows = SCOREBOARD_POOL;
+    }
+    return font != NULL;
+}
+
+static uint64_t lastFirstRow(const Scoreboard *board)
+{
+    return board->total > (uint64_t)board->visibleRows ? board->total - board->visibleRows : 0;
+}
+
+bool scoreboardRefresh(Scoreboard *board)
+{
+    // Journal en ajout seul : les lignes déjà rendues restent valides, seules des lignes s'ajoutent
+    uint64_t total = board->store != NULL ? scoresNombre(board->store) : 0;
+    if (total == board->total)
+    {
+        return false;
+    }
+    board->total = total;
+    return true;
+}
+
+bool scoreboardScroll(Scoreboard *board, const SDL_Event *e)
+{
+    int64_t delta;
+    if (e->type == SDL_MOUSEWHEEL)
+    {
+        // Molette vers le haut : lignes précédentes
+        delta = -(int64_t)e->wheel.y * SCOREBOARD_WHEEL_ROWS;
+    }
+    else if (e->type == SDL_KEYDOWN)
+    {
+        switch (e->key.keysym.sym)
+        {
+        case SDLK_UP:
+            delta = -1;
+            break;
+        case SDLK_DOWN:
+            delta = 1;
+            break;
+        case SDLK_PAGEUP:
+            delta = -board->visibleRows;
+            break;
+        case SDLK_PAGEDOWN:
+            delta = board->visibleRows;
+            break;
+        case SDLK_HOME:
+            delta = INT64_MIN;
+            break;
+        case SDLK_END:
+            delta = INT64_MAX;
+            break;
+        default:
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    uint64_t last = lastFirstRow(board);
+    uint64_t first;
+    if (delta < 0)
+    {
+        uint64_t up = delta == INT64_MIN ? UINT64_MAX : (uint64_t)-delta;
+        first = board->firstRow > up ? board->firstRow - up : 0;
+    }
+    else
+    {
+        first = last - board->firstRow > (uint64_t)delta ? board->firstRow + delta : last;
+    }
+    if (first == board->firstRow)
+    {
+        return false;
+    }
+    board->firstRow = first;
+    return true;
+}
+
+// Réécrit la texture de la ligne avec le texte de l'enregistrement
+static void fillRow(Scoreboard *board, SDL_Renderer *renderer, ScoreRow *row, uint64_t record, const ScoreEnregistrement *score)
+{
+    if (row->texture == NULL)
+    {
+        row->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, board->view.w, board->lineHeight);
+        if (row->texture == NULL)
+        {
+            TRACE_ERREUR(TRACE_RENDU, "Unable to create score row texture! SDL Error: %s", SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(row->texture, SDL_BLENDMODE_BLEND);
+    }
+
+    char line[SCORE_NOM_MAX + 16];
+    snprintf(line, sizeof(line), "%.*s, %d", SCORE_NOM_MAX - 1, score->nom, score->score);
+    SDL_Color textColor = {255, 255, 255, 255};
+    SDL_Surface *textSurface = TTF_RenderUTF8_Blended(board->font, line, textColor);
+    if (textSurface == NULL)
+    {
+        TRACE_ERREUR(TRACE_RENDU, "Unable to render text surface! SDL_ttf Error: %s", TTF_GetError());
+        return;
+    }
+    if (textSurface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+        SDL_Surface *converted = SDL_ConvertSurfaceFormat(textSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(textSurface);
+        if (converted == NULL)
+        {
+            TRACE_ERREUR(TRACE_RENDU, "Unable to convert score row! SDL Error: %s", SDL_GetError());
+            return;
+        }
+        textSurface = converted;
+    }
+
+    // Une ligne trop longue pour la vue est coupée à droite, avant la barre de défilement
+    int maxWidth = board->view.w - 2 * SCOREBOARD_SCROLLBAR_WIDTH;
+    row->w = textSurface->w < maxWidth ? textSurface->w : maxWidth;
+    row->h = textSurface->h < board->lineHeight ? textSurface->h : board->lineHeight;
+    SDL_Rect area = {0, 0, row->w, row->h};
+    if (SDL_UpdateTexture(row->texture, &area, textSurface->pixels, textSurface->pitch) == 0)
+    {
+        row->record = record;
+        row->filled = true;
+    }
+    SDL_FreeSurface(textSurface);
+}
+
+void scoreboardRender(Scoreboard *board, SDL_Renderer *renderer)
+{
+    uint64_t end = board->firstRow + board->visibleRows;
+    if (end > board->total)
+    {
+        end = board->total;
+    }
+
+    // Lignes visibles absentes du groupe (après un défilement) : lues sur place dans le journal,
+    // dont les total premiers enregistrements sont complets
+    for (uint64_t i = board->firstRow; i < end; i++)
+    {
+        ScoreRow *row = &board->pool[i % SCOREBOARD_POOL];
+        if (!row->filled || row->record != i)
+        {
+            fillRow(board, renderer, row, i, &scoresEnregistrements(board->store)[i]);
+        }
+        if (row->filled && row->record == i)
+        {
+            SDL_Rect source = {0, 0, row->w, row->h};
+            SDL_Rect textRect = {board->view.x, board->view.y + (int)(i - board->firstRow) * board->lineHeight, row->w, row->h};
+            SDL_RenderCopy(renderer, row->texture, &source, &textRect);
+        }
+    }
+
+    // Barre de défilement : position et taille de la vue dans tout le journal
+    if (board->total > (uint64_t)board->visibleRows)
+    {
+        SDL_Rect track = {board->view.x + board->view.w - SCOREBOARD_SCROLLBAR_WIDTH, board->view.y, SCOREBOARD_SCROLLBAR_WIDTH, board->view.h};
+        double scale = (double)track.h / (double)board->total;
+        int thumbHeight = (int)(board->visibleRows * scale);
+        SDL_Rect thumb = {track.x, track.y + (int)(board->firstRow * scale), track.w, thumbHeight < 4 ? 4 : thumbHeight};
+        if (thumb.y + thumb.h > track.y + track.h)
+        {
+            thumb.y = track.y + track.h - thumb.h;
+        }
+        SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
+        SDL_RenderFillRect(renderer, &track);
+        SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
+        SDL_RenderFillRect(renderer, &thumb);
+    }
+}
+
+void scoreboardFree(Scoreboard *board)
+{
+    for (int i = 0; i < SCOREBOARD_POOL; i++)
+    {
+        if (board->pool[i].texture != NULL)
+        {
+            SDL_DestroyTexture(board->pool[i].texture);
+            board->pool[i].texture = NULL;
+        }
+        board->pool[i].filled = false;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef SCOREBOARD_H
+#define SCOREBOARD_H
+
+// Tableau des scores en liste virtuelle : seules les lignes visibles sont lues dans le journal
+// et rendues en texture, dans un petit groupe de textures réutilisées d'une ligne à l'autre.
+// Le coût d'une image ne dépend que de la hauteur de la vue, pas du nombre de scores.
+// Le journal est lu directement dans sa projection partagée : les scores ajoutés par les
+// autres instances apparaissent dès la vérification suivante, sans relire de fichier.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "scores.h"
+
+// Textures de lignes ; au moins autant que de lignes visibles à la fois
+#define SCOREBOARD_POOL 32
+// Lignes parcourues par cran de molette
+#define SCOREBOARD_WHEEL_ROWS 3
+
+// Une texture du groupe, avec la ligne du journal qu'elle montre en ce moment
+typedef struct
+{
+    SDL_Texture *texture; // view.w x lineHeight, réécrite sur place
+    uint64_t record;
+    bool filled;
+    int w;
+    int h;
+} ScoreRow;
+
+typedef struct
+{
+    const ScoreStore *store; // NULL : pas de journal, liste vide
+    TTF_Font *font;
+    SDL_Rect view; // zone de la liste dans la fenêtre
+    int lineHeight;
+    int visibleRows;
+    ScoreRow pool[SCOREBOARD_POOL]; // la ligne i occupe pool[i % SCOREBOARD_POOL]
+    uint64_t total;    // enregistrements complets dans le journal
+    uint64_t firstRow; // première ligne affichée
+} Scoreboard;
+
+bool scoreboardInit(Scoreboard *board, const ScoreStore *store, TTF_Font *font, SDL_Rect view, int lineHeight);
+
+// Une lecture du compteur du journal ; true si des lignes sont arrivées : l'écran est à redessiner
+bool scoreboardRefresh(Scoreboard *board);
+
+// Molette, flèches, Page précédente/suivante, Début/Fin ; true si la vue a bougé
+bool scoreboardScroll(Scoreboard *board, const SDL_Event *e);
+
+void scoreboardRender(Scoreboard *board, SDL_Renderer *renderer);
+void scoreboardFree(Scoreboard *board);
+
+#endif
@@ -0,0 +1,566 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "scores.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SCORES_VERSION 1
+#define JOURNAL_VERSION 1
+#define JOURNAL_BLOC 1024         // enregistrements ajoutés à la taille du fichier à chaque agrandissement
+#define INDEX_PERIODE 256         // scores comptés entre deux sauvegardes de l'index, en plus de la fermeture
+#define IMPORT_LOT 256            // scores importés par verrou et par publication
+
+static const char MAGIC_JOURNAL[4] = {'B', 'K', 'S', 'L'};
+static const char MAGIC_INDEX[4] = {'B', 'K', 'S', 'I'};
+
+// Une ligne de cache : le compteur, seul champ modifié après la création, n'en partage aucune
+struct EnteteJournal
+{
+    char magic[4];
+    uint32_t version;
+    _Atomic uint64_t nombre; // enregistrements publiés : écrit sous verrou, lu sans verrou
+    uint8_t reserve[SCORES_ENTETE - 16];
+};
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t nbEnregistrements; // enregistrements du journal déjà pris en compte
+    uint32_t nbTop;
+    uint32_t nbJoueurs;
+} EnteteIndex;
+
+_Static_assert(sizeof(EnteteJournal) == SCORES_ENTETE, "en-tête du journal");
+// Le compteur est partagé entre processus : il ne doit jamais dépendre d'un verrou caché
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "compteur atomique sans verrou");
+
+// Copie un nom sans espaces autour, tronqué et complété par des zéros
+static void copierNom(char destination[SCORE_NOM_MAX], const char *nom)
+{
+    while (isspace((unsigned char)*nom))
+    {
+        nom++;
+    }
+    size_t longueur = strlen(nom);
+    while (longueur > 0 && isspace((unsigned char)nom[longueur - 1]))
+    {
+        longueur--;
+    }
+    if (longueur > SCORE_NOM_MAX - 1)
+    {
+        longueur = SCORE_NOM_MAX - 1;
+    }
+    memset(destination, 0, SCORE_NOM_MAX);
+    memcpy(destination, nom, longueur);
+}
+
+static uint64_t hacherNom(const char *nom)
+{
+    // FNV-1a
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (; *nom; nom++)
+    {
+        h = (h ^ (unsigned char)*nom) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+static bool reconstruireTable(ScoreStore *store, size_t capacite)
+{
+    int32_t *table = malloc(capacite * sizeof(int32_t));
+    if (table == NULL)
+    {
+        return false;
+    }
+    memset(table, 0xFF, capacite * sizeof(int32_t));
+
+    for (size_t j = 0; j < store->nbJoueurs; j++)
+    {
+        size_t i = hacherNom(store->joueurs[j].nom) & (capacite - 1);
+        while (table[i] >= 0)
+        {
+            i = (i + 1) & (capacite - 1);
+        }
+        table[i] = (int32_t)j;
+    }
+
+    free(store->table);
+    store->table = table;
+    store->capaciteTable = capacite;
+    return true;
+}
+
+static StatsJoueur *trouverOuCreer(ScoreStore *store, const char nom[SCORE_NOM_MAX])
+{
+    if (2 * (store->nbJoueurs + 1) > store->capaciteTable)
+    {
+        if (!reconstruireTable(store, store->capaciteTable ? store->capaciteTable * 2 : 64))
+        {
+            return NULL;
+        }
+    }
+
+    size_t i = hacherNom(nom) & (store->capaciteTable - 1);
+    while (store->table[i] >= 0)
+    {
+        StatsJoueur *joueur = &store->joueurs[store->table[i]];
+        if (strncmp(joueur->nom, nom, SCORE_NOM_MAX) == 0)
+        {
+            return joueur;
+        }
+        i = (i + 1) & (store->capaciteTable - 1);
+    }
+
+    if (store->nbJoueurs == store->capaciteJoueurs)
+    {
+        size_t capacite = store->capaciteJoueurs ? store->capaciteJoueurs * 2 : 32;
+        StatsJoueur *joueurs = realloc(store->joueurs, capacite * sizeof(StatsJoueur));
+        if (joueurs == NULL)
+        {
+            return NULL;
+        }
+        store->joueurs = joueurs;
+        store->capaciteJoueurs = capacite;
+    }
+
+    StatsJoueur *joueur = &store->joueurs[store->nbJoueurs];
+    memset(joueur, 0, sizeof(*joueur));
+    memcpy(joueur->nom, nom, SCORE_NOM_MAX);
+    store->table[i] = (int32_t)store->nbJoueurs++;
+    return joueur;
+}
+
+static void insererTop(ScoreStore *store, const ScoreEnregistrement *enregistrement)
+{
+    if (store->nbTop == SCORES_TOP_K && enregistrement->score <= store->top[SCORES_TOP_K - 1].score)
+    {
+        return;
+    }
+
+    // À score égal, le plus ancien reste devant
+    int position = store->nbTop < SCORES_TOP_K ? store->nbTop : SCORES_TOP_K - 1;
+    while (position > 0 && store->top[position - 1].score < enregistrement->score)
+    {
+        store->top[position] = store->top[position - 1];
+        position--;
+    }
+    store->top[position] = *enregistrement;
+    if (store->nbTop < SCORES_TOP_K)
+    {
+        store->nbTop++;
+    }
+}
+
+static void comptabiliser(ScoreStore *store, const ScoreEnregistrement *enregistrement)
+{
+    insererTop(store, enregistrement);
+
+    StatsJoueur *joueur = trouverOuCreer(store, enregistrement->nom);
+    if (joueur != NULL)
+    {
+        if (joueur->parties == 0 || enregistrement->score > joueur->meilleur)
+        {
+            joueur->meilleur = enregistrement->score;
+        }
+        joueur->total += enregistrement->score;
+        joueur->parties++;
+    }
+    store->nbEnregistrements++;
+}
+
+static void viderIndex(ScoreStore *store)
+{
+    store->nbEnregistrements = 0;
+    store->nbTop = 0;
+    store->nbJoueurs = 0;
+    if (store->table != NULL)
+    {
+        memset(store->table, 0xFF, store->capaciteTable * sizeof(int32_t));
+    }
+}
+
+static bool chargerIndex(ScoreStore *store)
+{
+    FILE *fichier = fopen(store->cheminIndex, "rb");
+    if (fichier == NULL)
+    {
+        return false;
+    }
+
+    EnteteIndex entete;
+    bool ok = fread(&entete, sizeof(entete), 1, fichier) == 1
+           && memcmp(entete.magic, MAGIC_INDEX, 4) == 0
+           && entete.version == SCORES_VERSION
+           && entete.nbTop <= SCORES_TOP_K
+           && fread(store->top, sizeof(ScoreEnregistrement), entete.nbTop, fichier) == entete.nbTop;
+
+    if (ok && entete.nbJoueurs > store->capaciteJoueurs)
+    {
+        StatsJoueur *joueurs = realloc(store->joueurs, entete.nbJoueurs * sizeof(StatsJoueur));
+        ok = joueurs != NULL;
+        if (ok)
+        {
+            store->joueurs = joueurs;
+            store->capaciteJoueurs = entete.nbJoueurs;
+        }
+    }
+    ok = ok && fread(store->joueurs, sizeof(StatsJoueur), entete.nbJoueurs, fichier) == entete.nbJoueurs;
+    fclose(fichier);
+
+    if (!ok)
+    {
+        viderIndex(store);
+        return false;
+    }
+
+    store->nbTop = (int)entete.nbTop;
+    store->nbJoueurs = entete.nbJoueurs;
+    store->nbEnregistrements = entete.nbEnregistrements;
+    store->nbSauves = entete.nbEnregistrements;
+
+    size_t capacite = 64;
+    while (capacite < 2 * (store->nbJoueurs + 1))
+    {
+        capacite *= 2;
+    }
+    if (!reconstruireTable(store, capacite))
+    {
+        viderIndex(store);
+        return false;
+    }
+    return true;
+}
+
+// Écrit l'index dans un fichier temporaire puis le renomme : jamais d'index à moitié écrit
+static bool sauverIndex(ScoreStore *store)
+{
+    // Un fichier temporaire par processus : plusieurs instances peuvent sauver l'index en même temps
+    char temporaire[512];
+    snprintf(temporaire, sizeof(temporaire), "%s.%ld.tmp", store->cheminIndex, (long)getpid());
+
+    FILE *fichier = fopen(temporaire, "wb");
+    if (fichier == NULL)
+    {
+        fprintf(stderr, "Erreur d'écriture de l'index des scores %s.\n", temporaire);
+        return false;
+    }
+
+    EnteteIndex entete = {{0}, SCORES_VERSION, store->nbEnregistrements, (uint32_t)store->nbTop, (uint32_t)store->nbJoueurs};
+    memcpy(entete.magic, MAGIC_INDEX, 4);
+    bool ok = fwrite(&entete, sizeof(entete), 1, fichier) == 1
+           && fwrite(store->top, sizeof(ScoreEnregistrement), store->nbTop, fichier) == (size_t)store->nbTop
+           && fwrite(store->joueurs, sizeof(StatsJoueur), store->nbJoueurs, fichier) == store->nbJoueurs;
+    ok = fclose(fichier) == 0 && ok;
+
+    if (!ok || rename(temporaire, store->cheminIndex) != 0)
+    {
+        fprintf(stderr, "Erreur d'écriture de l'index des scores %s.\n", store->cheminIndex);
+        remove(temporaire);
+        return false;
+    }
+    store->nbSauves = store->nbEnregistrements;
+    return true;
+}
+
+// Verrou d'écriture sur tout le journal, entre processus ; libéré par le noyau si le processus meurt
+static bool verrouiller(int descripteur, short type)
+{
+    struct flock verrou = {.l_type = type, .l_whence = SEEK_SET, .l_start = 0, .l_len = 0};
+    while (fcntl(descripteur, F_SETLKW, &verrou) != 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Ouvre (et crée au besoin) le journal et prend son verrou
+static int ouvrirVerrouille(const char *chemin)
+{
+    int descripteur = open(chemin, O_RDWR | O_CREAT, 0644);
+    if (descripteur >= 0 && !verrouiller(descripteur, F_WRLCK))
+    {
+        close(descripteur);
+        return -1;
+    }
+    return descripteur;
+}
+
+static off_t tailleJournal(uint64_t nombre)
+{
+    uint64_t blocs = (nombre + JOURNAL_BLOC - 1) / JOURNAL_BLOC;
+    return (off_t)(SCORES_ENTETE + (blocs ? blocs : 1) * JOURNAL_BLOC * sizeof(ScoreEnregistrement));
+}
+
+static long importerTexte(ScoreStore *store, const char *cheminTexte, bool verrouPris);
+
+// Ouvre (et crée au besoin) le journal, vérifie son en-tête et le projette en mémoire.
+// Tout se fait sous le verrou : deux instances lancées ensemble ne créent pas deux en-têtes,
+// et seule celle qui crée le journal y importe l'ancien fichier texte.
+static bool projeterJournal(ScoreStore *store, const char *cheminAncien)
+{
+    int descripteur = ouvrirVerrouille(store->cheminJournal);
+    if (descripteur < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    EnteteJournal entete;
+    bool ok = fstat(descripteur, &st) == 0;
+    bool nouveau = ok && st.st_size == 0;
+    if (nouveau)
+    {
+        // Nouveau journal : en-tête et premier bloc, nombre à zéro
+        memset(&entete, 0, sizeof(entete));
+        memcpy(entete.magic, MAGIC_JOURNAL, 4);
+        entete.version = JOURNAL_VERSION;
+        ok = pwrite(descripteur, &entete, sizeof(entete), 0) == (ssize_t)sizeof(entete)
+          && ftruncate(descripteur, tailleJournal(0)) == 0;
+        st.st_size = tailleJournal(0);
+    }
+    ok = ok && st.st_size >= SCORES_ENTETE
+            && pread(descripteur, &entete, sizeof(entete.magic) + sizeof(entete.version), 0) == (ssize_t)(sizeof(entete.magic) + sizeof(entete.version))
+            && memcmp(entete.magic, MAGIC_JOURNAL, 4) == 0 && entete.version == JOURNAL_VERSION;
+
+    void *carte = ok ? mmap(NULL, SCORES_CARTE_MAX, PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0) : MAP_FAILED;
+    if (carte == MAP_FAILED)
+    {
+        fprintf(stderr, "%s n'est pas un journal de scores valide.\n", store->cheminJournal);
+        verrouiller(descripteur, F_UNLCK);
+        close(descripteur);
+        return false;
+    }
+    store->descripteur = descripteur;
+    store->journal = carte;
+
+    // Premier lancement : les instances qui attendent le verrou trouveront le journal déjà rempli
+    if (nouveau && cheminAncien != NULL && access(cheminAncien, R_OK) == 0)
+    {
+        long importes = importerTexte(store, cheminAncien, true);
+        if (importes >= 0)
+        {
+            printf("%ld scores importés depuis %s\n", importes, cheminAncien);
+        }
+    }
+    verrouiller(descripteur, F_UNLCK);
+    return true;
+}
+
+uint64_t scoresNombre(const ScoreStore *store)
+{
+    if (store->journal == NULL)
+    {
+        return 0;
+    }
+    // acquire : les enregistrements comptés ont été écrits avant la publication du compteur
+    return atomic_load_explicit(&store->journal->nombre, memory_order_acquire);
+}
+
+const ScoreEnregistrement *scoresEnregistrements(const ScoreStore *store)
+{
+    return (const ScoreEnregistrement *)((const char *)store->journal + SCORES_ENTETE);
+}
+
+// Ajoute des enregistrements à la fin du journal : écrits dans la projection, puis publiés
+// d'un coup par le compteur. Un lecteur ne voit jamais un enregistrement à moitié écrit,
+// et un écrivain qui meurt avant la publication ne laisse rien de visible.
+// verrouPris : l'appelant tient déjà le verrou du journal, et le garde
+static bool ajouterAuJournal(ScoreStore *store, const ScoreEnregistrement *enregistrements, size_t nombreAjoutes, bool verrouPris)
+{
+    if (!verrouPris && !verrouiller(store->descripteur, F_WRLCK))
+    {
+        return false;
+    }
+
+    uint64_t nombre = atomic_load_explicit(&store->journal->nombre, memory_order_relaxed);
+    bool ok = nombre + nombreAjoutes <= SCORES_MAX_ENREGISTREMENTS;
+    struct stat st;
+    off_t taille = tailleJournal(nombre + nombreAjoutes);
+    ok = ok && fstat(store->descripteur, &st) == 0 && (st.st_size >= taille || ftruncate(store->descripteur, taille) == 0);
+    if (ok)
+    {
+        ScoreEnregistrement *fin = (ScoreEnregistrement *)((char *)store->journal + SCORES_ENTETE) + nombre;
+        memcpy(fin, enregistrements, nombreAjoutes * sizeof(ScoreEnregistrement));
+        atomic_store_explicit(&store->journal->nombre, nombre + nombreAjoutes, memory_order_release);
+    }
+
+    if (!verrouPris)
+    {
+        verrouiller(store->descripteur, F_UNLCK);
+    }
+    return ok;
+}
+
+void scoresRattraper(ScoreStore *store)
+{
+    uint64_t nombre = scoresNombre(store);
+    while (store->nbEnregistrements < nombre)
+    {
+        comptabiliser(store, &scoresEnregistrements(store)[store->nbEnregistrements]);
+    }
+}
+
+bool scoresOuvrir(ScoreStore *store, const char *cheminJournal, const char *cheminIndex, const char *cheminAncien)
+{
+    memset(store, 0, sizeof(*store));
+    store->cheminJournal = cheminJournal;
+    store->cheminIndex = cheminIndex;
+    store->descripteur = -1;
+
+    if (!projeterJournal(store, cheminAncien))
+    {
+        return false;
+    }
+
+    // Index absent, illisible ou plus récent que le journal : on le reconstruit
+    uint64_t nombreJournal = scoresNombre(store);
+    if (!chargerIndex(store) || store->nbEnregistrements > nombreJournal)
+    {
+        viderIndex(store);
+    }
+
+    if (store->nbEnregistrements < nombreJournal)
+    {
+        scoresRattraper(store);
+        sauverIndex(store);
+    }
+    return true;
+}
+
+bool scoresAjouter(ScoreStore *store, const char *nom, int score)
+{
+    ScoreEnregistrement enregistrement;
+    copierNom(enregistrement.nom, nom);
+    enregistrement.score = score;
+
+    if (!ajouterAuJournal(store, &enregistrement, 1, false))
+    {
+        fprintf(stderr, "Erreur d'écriture du fichier des scores.\n");
+        return false;
+    }
+
+    // Les scores des autres instances arrivés entre-temps, puis le nôtre, dans l'ordre du journal.
+    // L'index n'est réécrit que de temps en temps : un index en retard se rattrape à l'ouverture.
+    scoresRattraper(store);
+    if (store->nbEnregistrements - store->nbSauves >= INDEX_PERIODE)
+    {
+        sauverIndex(store);
+    }
+    return true;
+}
+
+int scoresTop(const ScoreStore *store, const ScoreEnregistrement **top)
+{
+    *top = store->top;
+    return store->nbTop;
+}
+
+const StatsJoueur *scoresJoueur(const ScoreStore *store, const char *nom)
+{
+    if (store->capaciteTable == 0)
+    {
+        return NULL;
+    }
+
+    char cle[SCORE_NOM_MAX];
+    copierNom(cle, nom);
+    size_t i = hacherNom(cle) & (store->capaciteTable - 1);
+    while (store->table[i] >= 0)
+    {
+        const StatsJoueur *joueur = &store->joueurs[store->table[i]];
+        if (strncmp(joueur->nom, cle, SCORE_NOM_MAX) == 0)
+        {
+            return joueur;
+        }
+        i = (i + 1) & (store->capaciteTable - 1);
+    }
+    return NULL;
+}
+
+static long importerTexte(ScoreStore *store, const char *cheminTexte, bool verrouPris)
+{
+    FILE *texte = fopen(cheminTexte, "r");
+    if (texte == NULL)
+    {
+        fprintf(stderr, "Impossible d'ouvrir %s.\n", cheminTexte);
+        return -1;
+    }
+
+    // Par lots : une publication (et un verrou, s'il n'est pas déjà pris) pour IMPORT_LOT scores
+    ScoreEnregistrement lot[IMPORT_LOT];
+    size_t dansLot = 0;
+    long importes = 0;
+    bool ok = true;
+    char ligne[256];
+    while (ok && fgets(ligne, sizeof(ligne), texte))
+    {
+        // Format de saveScore : "nom, score" (le nom peut lui-même contenir des virgules)
+        char *virgule = strrchr(ligne, ',');
+        if (virgule == NULL)
+        {
+            continue;
+        }
+        *virgule = '\0';
+
+        copierNom(lot[dansLot].nom, ligne);
+        lot[dansLot].score = (int32_t)strtol(virgule + 1, NULL, 10);
+        if (++dansLot == sizeof(lot) / sizeof(lot[0]))
+        {
+            ok = ajouterAuJournal(store, lot, dansLot, verrouPris);
+            importes += ok ? (long)dansLot : 0;
+            dansLot = 0;
+        }
+    }
+    if (ok && dansLot > 0)
+    {
+        ok = ajouterAuJournal(store, lot, dansLot, verrouPris);
+        importes += ok ? (long)dansLot : 0;
+    }
+    fclose(texte);
+    if (!ok)
+    {
+        fprintf(stderr, "Erreur d'écriture du fichier des scores.\n");
+    }
+
+    scoresRattraper(store);
+    return sauverIndex(store) && ok ? importes : -1;
+}
+
+long scoresImporterTexte(ScoreStore *store, const char *cheminTexte)
+{
+    return importerTexte(store, cheminTexte, false);
+}
+
+void scoresFermer(ScoreStore *store)
+{
+    // Les scores comptés depuis la dernière sauvegarde de l'index
+    if (store->journal != NULL && store->nbEnregistrements != store->nbSauves)
+    {
+        sauverIndex(store);
+    }
+    if (store->journal != NULL)
+    {
+        munmap(store->journal, SCORES_CARTE_MAX);
+    }
+    if (store->descripteur >= 0)
+    {
+        close(store->descripteur);
+    }
+    free(store->joueurs);
+    free(store->table);
+    memset(store, 0, sizeof(*store));
+    store->descripteur = -1;
+}
@@ -0,0 +1,92 @@
+#ifndef SCORES_H
+#define SCORES_H
+
+// Stockage des scores, sans dépendance à SDL.
+//
+// scores.bin : journal binaire en ajout seul (en-tête puis enregistrements de taille fixe),
+//              projeté en mémoire et partagé par toutes les instances du jeu sur la machine.
+//              Un ajout se fait sous un verrou de fichier ; un enregistrement n'est visible
+//              qu'une fois complet, quand le compteur de l'en-tête l'englobe. La lecture ne
+//              prend aucun verrou : chaque instance voit aussitôt les scores des autres.
+// scores.idx : petit index à côté du journal, avec le top K et les statistiques de chaque
+//              joueur (meilleur score, total, nombre de parties). Il est chargé en mémoire
+//              à l'ouverture : « top 10 » et « mon meilleur score » ne parcourent jamais le journal.
+//              Il n'est réécrit qu'à la fermeture et de loin en loin, jamais à chaque score.
+// Si l'index manque ou est en retard sur le journal, il est reconstruit à partir de la fin du journal.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define SCORES_TOP_K 10
+#define SCORE_NOM_MAX 28 // 27 caractères + '\0'
+
+#define SCORES_JOURNAL "scores.bin"
+#define SCORES_INDEX "scores.idx"
+
+typedef struct
+{
+    char nom[SCORE_NOM_MAX];
+    int32_t score;
+} ScoreEnregistrement;
+
+_Static_assert(sizeof(ScoreEnregistrement) == 32, "un enregistrement fait 32 octets");
+
+typedef struct
+{
+    char nom[SCORE_NOM_MAX];
+    int32_t meilleur;
+    int64_t total;
+    uint32_t parties;
+    uint32_t reserve;
+} StatsJoueur;
+
+typedef struct EnteteJournal EnteteJournal;
+
+typedef struct
+{
+    const char *cheminJournal;
+    const char *cheminIndex;
+    int descripteur;           // journal ouvert, pour son verrou et son agrandissement
+    EnteteJournal *journal;    // projection partagée du journal ; enregistrements juste après
+    uint64_t nbEnregistrements; // enregistrements du journal pris en compte dans le top et les statistiques
+    uint64_t nbSauves;          // nbEnregistrements lors de la dernière sauvegarde de l'index
+    ScoreEnregistrement top[SCORES_TOP_K];
+    int nbTop;
+    StatsJoueur *joueurs;
+    size_t nbJoueurs;
+    size_t capaciteJoueurs;
+    int32_t *table; // table de hachage nom -> indice dans joueurs (-1 si vide)
+    size_t capaciteTable;
+} ScoreStore;
+
+// Taille de l'en-tête du journal : l'enregistrement i commence à SCORES_ENTETE + i * 32
+#define SCORES_ENTETE 64
+// Espace d'adresses réservé à la projection : le journal grandit dedans sans jamais être reprojeté
+#define SCORES_CARTE_MAX ((size_t)1 << 30)
+#define SCORES_MAX_ENREGISTREMENTS ((SCORES_CARTE_MAX - SCORES_ENTETE) / sizeof(ScoreEnregistrement))
+
+// cheminAncien : ancien fichier texte « nom, score » importé si le journal vient d'être créé (NULL : aucun)
+bool scoresOuvrir(ScoreStore *store, const char *cheminJournal, const char *cheminIndex, const char *cheminAncien);
+bool scoresAjouter(ScoreStore *store, const char *nom, int score);
+void scoresFermer(ScoreStore *store);
+
+// Meilleurs scores, du plus haut au plus bas ; retourne leur nombre
+int scoresTop(const ScoreStore *store, const ScoreEnregistrement **top);
+
+// Statistiques d'un joueur, ou NULL s'il n'a jamais gagné
+const StatsJoueur *scoresJoueur(const ScoreStore *store, const char *nom);
+
+// Importe un ancien fichier texte « nom, score » ; retourne le nombre de scores importés ou -1
+long scoresImporterTexte(ScoreStore *store, const char *cheminTexte);
+
+// Lecture directe du journal partagé, sans verrou ni copie : les scoresNombre() premiers
+// enregistrements sont complets et ne changeront plus, quel que soit l'écrivain
+uint64_t scoresNombre(const ScoreStore *store);
+const ScoreEnregistrement *scoresEnregistrements(const ScoreStore *store);
+
+// Compte dans le top et les statistiques les scores ajoutés depuis par les autres instances
+void scoresRattraper(ScoreStore *store);
+
+#endif
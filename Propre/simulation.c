@@ -0,0 +1,549 @@
+// Simulateur sans fenêtre : joue des millions de matchs complets (3 manches)
+// sur tous les coeurs et écrit les statistiques en CSV sur la sortie standard.
+//
+// Usage : ./Buckshot_Simulation [-n matchs] [-t threads] [-s graine] [-o | -v]
+//
+// -v : mode par voies. Chaque thread fait avancer VOIES matchs en même temps, un octet par
+// match dans des vecteurs (extensions vectorielles de GCC) : chargeurs, vies et tours sont
+// mis à jour pour toutes les voies par les mêmes opérations, sans branchement. Une voie dont
+// la manche se termine est masquée puis repart aussitôt sur une nouvelle manche ou un nouveau
+// match. Mêmes règles et même politique (heuristique, sans objets) que le mode normal, mais
+// d'autres tirages : les résultats sont égaux en loi, pas au tir près.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "regles.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 256
+
+// Nombre de matchs par thread en mode -v : une puissance de 2 entre 8 et 64 (-DVOIES=16)
+#ifndef VOIES
+#define VOIES 64
+#endif
+
+_Static_assert(VOIES >= 8 && VOIES <= 64 && (VOIES & (VOIES - 1)) == 0, "VOIES : 8, 16, 32 ou 64");
+
+// -o : les deux camps utilisent leurs objets (jouerObjets) avant chaque tir
+static bool avecObjets = false;
+
+// -v : matchs joués par voies
+static bool parVoies = false;
+
+typedef struct
+{
+    long long manchesJouees[NB_MANCHES];
+    long long defaitesJoueur[NB_MANCHES];
+    long long tirsTotal[NB_MANCHES];
+    int tirsMin[NB_MANCHES];
+    int tirsMax[NB_MANCHES];
+    long long victoiresJoueur;
+    long long matchs;
+} Statistiques;
+
+// Chaque thread a son propre état, aligné sur une ligne de cache
+typedef struct
+{
+    _Alignas(64) Statistiques stats;
+    Alea alea;
+    long long matchsAJouer;
+} Travailleur;
+
+static void initialiserStatistiques(Statistiques *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        stats->tirsMin[m] = 1 << 30;
+    }
+}
+
+// Les voies sont rangées par paquets de la largeur des registres vectoriels : GCC découpe mal
+// un vecteur plus large que le matériel (octet par octet), d'où une boucle sur les paquets
+#if defined(__AVX512BW__)
+#define LARGEUR_REGISTRE 64
+#elif defined(__AVX2__)
+#define LARGEUR_REGISTRE 32
+#else
+#define LARGEUR_REGISTRE 16
+#endif
+#define LARGEUR (VOIES < LARGEUR_REGISTRE ? VOIES : LARGEUR_REGISTRE)
+#define PAQUETS (VOIES / LARGEUR)
+
+// Un octet par voie ; les comparaisons donnent 0xFF (vrai) ou 0 dans chaque voie
+typedef uint8_t Octets __attribute__((vector_size(LARGEUR)));
+typedef uint64_t Generateurs __attribute__((vector_size(LARGEUR))); // LARGEUR / 8 générateurs de 64 bits
+
+// xoshiro256** sur LARGEUR / 8 flux à la fois : un octet aléatoire par voie et par appel.
+// Aucune conversion entre largeurs de vecteurs : les tirages de 16 bits sont faits de deux octets.
+typedef struct
+{
+    Generateurs s[4];
+} AleaVoies;
+
+// Un paquet de voies : un match par voie
+typedef struct
+{
+    Octets balles;     // même codage que Partie::balles
+    Octets nombre;
+    Octets vieJoueur;  // une manche se termine dès qu'une vie atteint 0
+    Octets vieOrdi;
+    Octets tourJoueur; // 0xFF : au joueur
+    Octets manche;
+    Octets tirs;       // tirs de la manche en cours
+    Octets compte;     // 0xFF : le match en cours fait partie des matchs demandés
+    AleaVoies alea;
+} Voies;
+
+// Statistiques par voie, sur un octet : versées dans Statistiques avant de pouvoir déborder
+typedef struct
+{
+    Octets manchesJouees[NB_MANCHES];
+    Octets defaitesJoueur[NB_MANCHES];
+    Octets tirs[NB_MANCHES]; // un par tir d'une manche comptée
+    Octets tirsMin[NB_MANCHES];
+    Octets tirsMax[NB_MANCHES];
+    Octets victoiresJoueur;
+    Octets matchs;
+} CumulsVoies;
+
+#define SEUIL_TIERS 21846 // tirage de 16 bits sous ce seuil : probabilité 1/3, comme aleaBorne(alea, 3) == 0
+#define TIRS_PAR_VERSEMENT 255 // chaque tir ajoute au plus 1 à chaque cumul
+
+// Nombre de balles : aleaBorne(alea, 7) sur 16 bits vaut le nombre de seuils k * 65536 / 7 atteints
+#define SEUIL_NOMBRE(k) ((uint16_t)(((k) * 65536 + 6) / 7))
+
+static void aleaVoiesInit(AleaVoies *alea, Alea *source)
+{
+    for (int f = 0; f < LARGEUR / 8; f++)
+    {
+        Alea flux;
+        aleaInit(&flux, aleaSuivant(source));
+        for (int k = 0; k < 4; k++)
+        {
+            alea->s[k][f] = flux.s[k];
+        }
+    }
+}
+
+// Les vecteurs passent par pointeur : les passer par valeur dépendrait de l'ABI du processeur
+static inline void aleaVoiesSuivant(AleaVoies *alea, Octets *tirage)
+{
+    Generateurs *s = alea->s;
+    // Multiplications par 5 et 9 en décalages : sans AVX-512, aucun processeur x86 ne multiplie des vecteurs de 64 bits
+    Generateurs x = (s[1] << 2) + s[1];
+    x = (x << 7) | (x >> 57);
+    Generateurs resultat = (x << 3) + x;
+    Generateurs t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    *tirage = (Octets)resultat;
+}
+
+// Vrai dans les voies où le tirage de 16 bits (haut << 8 | bas) est sous le seuil
+static inline void sousSeuil(const Octets *haut, const Octets *bas, uint16_t seuil, Octets *resultat)
+{
+    uint8_t h = (uint8_t)(seuil >> 8);
+    *resultat = (Octets)(*haut < h) | ((Octets)(*haut == h) & (Octets)(*bas < (uint8_t)seuil));
+}
+
+static inline void compterRouges(const Octets *balles, Octets *rouges)
+{
+    Octets x = *balles;
+    x = x - ((x >> 1) & 0x55);
+    x = (x & 0x33) + ((x >> 2) & 0x33);
+    *rouges = (x + (x >> 4)) & 0x0F;
+}
+
+// Nombre de voies du paquet où le masque est vrai
+static inline int compterVoies(const Octets *masque)
+{
+    uint64_t mots[LARGEUR / 8];
+    memcpy(mots, masque, sizeof(mots));
+    int total = 0;
+    for (int i = 0; i < LARGEUR / 8; i++)
+    {
+        total += __builtin_popcountll(mots[i] & 0x0101010101010101ULL);
+    }
+    return total;
+}
+
+static inline void choisir(Octets *resultat, const Octets *masque, const Octets *siVrai)
+{
+    *resultat = (*masque & *siVrai) | (~*masque & *resultat);
+}
+
+static void initialiserCumuls(CumulsVoies *cumuls)
+{
+    memset(cumuls, 0, sizeof(*cumuls));
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        cumuls->tirsMin[m] = (Octets){0} + UINT8_MAX;
+    }
+}
+
+static void verserCumuls(CumulsVoies *cumuls, Statistiques *stats)
+{
+    for (int v = 0; v < LARGEUR; v++)
+    {
+        for (int m = 0; m < NB_MANCHES; m++)
+        {
+            stats->manchesJouees[m] += cumuls->manchesJouees[m][v];
+            stats->defaitesJoueur[m] += cumuls->defaitesJoueur[m][v];
+            stats->tirsTotal[m] += cumuls->tirs[m][v];
+            if (cumuls->manchesJouees[m][v] > 0 && cumuls->tirsMin[m][v] < stats->tirsMin[m])
+            {
+                stats->tirsMin[m] = cumuls->tirsMin[m][v];
+            }
+            if (cumuls->tirsMax[m][v] > stats->tirsMax[m])
+            {
+                stats->tirsMax[m] = cumuls->tirsMax[m][v];
+            }
+        }
+        stats->victoiresJoueur += cumuls->victoiresJoueur[v];
+        stats->matchs += cumuls->matchs[v];
+    }
+    initialiserCumuls(cumuls);
+}
+
+// Fins de manche de tout un paquet à la fois : statistiques, puis manche suivante ou nouveau match
+static void finirManches(Voies *voies, CumulsVoies *cumuls, const Octets *finie, long long *aCommencer)
+{
+    Octets perdu = (Octets)(voies->vieJoueur == 0);
+    Octets finMatch = *finie & (perdu | (Octets)(voies->manche == NB_MANCHES));
+    Octets comptee = *finie & voies->compte;
+
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        Octets ici = comptee & (Octets)(voies->manche == (uint8_t)(m + 1));
+        cumuls->manchesJouees[m] -= ici;
+        cumuls->defaitesJoueur[m] -= ici & perdu;
+        Octets plusPetit = ici & (Octets)(voies->tirs < cumuls->tirsMin[m]);
+        Octets plusGrand = ici & (Octets)(voies->tirs > cumuls->tirsMax[m]);
+        choisir(&cumuls->tirsMin[m], &plusPetit, &voies->tirs);
+        choisir(&cumuls->tirsMax[m], &plusGrand, &voies->tirs);
+    }
+    cumuls->victoiresJoueur -= comptee & finMatch & ~perdu;
+    cumuls->matchs -= comptee & finMatch;
+
+    // Nouveau match : compté tant qu'il en reste à commencer. Voie par voie seulement
+    // à la fin, quand il en reste moins que de voies qui terminent.
+    int nouveaux = compterVoies(&finMatch);
+    if (*aCommencer >= nouveaux)
+    {
+        *aCommencer -= nouveaux;
+    }
+    else
+    {
+        for (int v = 0; v < LARGEUR; v++)
+        {
+            if (finMatch[v])
+            {
+                voies->compte[v] = *aCommencer > 0 ? 0xFF : 0;
+                *aCommencer -= *aCommencer > 0;
+            }
+        }
+    }
+
+    // debuterManche : vies entre 3 et 6, le joueur commence, et un chargeur neuf (nombre à 0)
+    Octets tirage;
+    aleaVoiesSuivant(&voies->alea, &tirage);
+    Octets vie = (tirage >> 6) + 3;
+    voies->manche += *finie & 1;
+    voies->manche = (finMatch & 1) | (~finMatch & voies->manche);
+    choisir(&voies->vieJoueur, finie, &vie);
+    choisir(&voies->vieOrdi, finie, &vie);
+    voies->tourJoueur |= *finie;
+    voies->tirs &= ~*finie;
+    voies->nombre &= ~*finie;
+}
+
+// Un tir dans chaque voie du paquet, chargeur vide rempli avant
+static void tirerVoies(Voies *voies, CumulsVoies *cumuls, long long *aCommencer)
+{
+    // genererBalles pour toutes les voies, gardé seulement là où le chargeur est vide.
+    // Ni multiplication ni décalage variable, absents des jeux d'instructions courants :
+    // on compte les seuils atteints, et le masque s'allume balle par balle.
+    Octets vide = (Octets)(voies->nombre == 0);
+    Octets haut, bas, balles;
+    aleaVoiesSuivant(&voies->alea, &haut);
+    aleaVoiesSuivant(&voies->alea, &bas);
+    aleaVoiesSuivant(&voies->alea, &balles);
+    Octets nombre = (Octets){0} + MAX_BALLES;
+    Octets masque = (Octets){0} + UINT8_MAX;
+    for (int k = 1; k < MAX_BALLES - 1; k++)
+    {
+        Octets sous;
+        sousSeuil(&haut, &bas, SEUIL_NOMBRE(k), &sous);
+        nombre += sous;
+        masque &= ~(sous & (uint8_t)(0x80u >> (MAX_BALLES - 2 - k)));
+    }
+    Octets derniere = masque ^ (masque >> 1);
+    balles &= masque;
+    // Au moins une balle de chaque couleur : on force la dernière si besoin
+    balles |= (Octets)(balles == 0) & derniere;
+    balles &= ~((Octets)(balles == masque) & derniere);
+    choisir(&voies->balles, &vide, &balles);
+    choisir(&voies->nombre, &vide, &nombre);
+
+    // politiqueHeuristique : plus de rouges, l'adversaire ; plus de noires, soi-même ;
+    // égalité, soi-même une fois sur trois
+    Octets rouges, tiers;
+    aleaVoiesSuivant(&voies->alea, &haut);
+    aleaVoiesSuivant(&voies->alea, &bas);
+    sousSeuil(&haut, &bas, SEUIL_TIERS, &tiers);
+    compterRouges(&voies->balles, &rouges);
+    Octets noirs = voies->nombre - rouges;
+    Octets soi = (Octets)(noirs > rouges) | ((Octets)(noirs == rouges) & tiers);
+
+    // tirer : une balle rouge touche le joueur s'il se vise, ou si le dealer vise son adversaire
+    Octets rouge = -(voies->balles & 1);
+    Octets surJoueur = ~(soi ^ voies->tourJoueur);
+    voies->vieJoueur -= rouge & surJoueur & 1;
+    voies->vieOrdi -= rouge & ~surJoueur & 1;
+    voies->tourJoueur ^= rouge | ~soi;
+    voies->balles >>= 1;
+    voies->nombre -= 1;
+    voies->tirs += 1;
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        cumuls->tirs[m] -= voies->compte & (Octets)(voies->manche == (uint8_t)(m + 1));
+    }
+
+    Octets finie = (Octets)(voies->vieJoueur == 0) | (Octets)(voies->vieOrdi == 0);
+    finirManches(voies, cumuls, &finie, aCommencer);
+}
+
+static void jouerParVoies(Travailleur *travailleur)
+{
+    Statistiques *stats = &travailleur->stats;
+    long long aCommencer = travailleur->matchsAJouer;
+    Voies voies[PAQUETS];
+    CumulsVoies cumuls[PAQUETS];
+    CumulsVoies ignores;
+
+    memset(voies, 0, sizeof(voies));
+    Octets toutes = (Octets){0} + UINT8_MAX;
+    long long illimite = LLONG_MAX;
+    for (int p = 0; p < PAQUETS; p++)
+    {
+        aleaVoiesInit(&voies[p].alea, &travailleur->alea);
+        initialiserCumuls(&cumuls[p]);
+        for (int v = 0; v < LARGEUR; v++)
+        {
+            voies[p].compte[v] = aCommencer > 0 ? 0xFF : 0;
+            aCommencer -= aCommencer > 0;
+        }
+        // Toutes les voies partent d'une fin de match fictive, non comptée : elle leur donne un match neuf
+        voies[p].manche = (Octets){0} + NB_MANCHES;
+        initialiserCumuls(&ignores);
+        finirManches(&voies[p], &ignores, &toutes, &illimite);
+    }
+
+    for (int tirs = 1;; tirs++)
+    {
+        int actives = 0;
+        for (int p = 0; p < PAQUETS; p++)
+        {
+            tirerVoies(&voies[p], &cumuls[p], &aCommencer);
+            actives += compterVoies(&voies[p].compte);
+        }
+        if (actives == 0 || tirs % TIRS_PAR_VERSEMENT == 0)
+        {
+            for (int p = 0; p < PAQUETS; p++)
+            {
+                verserCumuls(&cumuls[p], stats);
+            }
+        }
+        if (actives == 0)
+        {
+            return;
+        }
+    }
+}
+
+static void *travailler(void *arg)
+{
+    Travailleur *travailleur = arg;
+    Statistiques *stats = &travailleur->stats;
+    Partie partie;
+    ResultatMatch resultat;
+
+    if (parVoies)
+    {
+        jouerParVoies(travailleur);
+        return NULL;
+    }
+
+    for (long long i = 0; i < travailleur->matchsAJouer; i++)
+    {
+        jouerMatch(&partie, politiqueHeuristique, politiqueHeuristique, avecObjets, &travailleur->alea, &resultat);
+
+        for (int m = 0; m < resultat.manchesJouees; m++)
+        {
+            int tirs = resultat.tirs[m];
+            stats->manchesJouees[m]++;
+            stats->tirsTotal[m] += tirs;
+            if (tirs < stats->tirsMin[m])
+            {
+                stats->tirsMin[m] = tirs;
+            }
+            if (tirs > stats->tirsMax[m])
+            {
+                stats->tirsMax[m] = tirs;
+            }
+        }
+        if (resultat.joueurGagne)
+        {
+            stats->victoiresJoueur++;
+        }
+        else
+        {
+            stats->defaitesJoueur[resultat.manchesJouees - 1]++;
+        }
+    }
+    stats->matchs = travailleur->matchsAJouer;
+    return NULL;
+}
+
+static void fusionnerStatistiques(Statistiques *total, const Statistiques *stats)
+{
+    total->matchs += stats->matchs;
+    total->victoiresJoueur += stats->victoiresJoueur;
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        total->manchesJouees[m] += stats->manchesJouees[m];
+        total->defaitesJoueur[m] += stats->defaitesJoueur[m];
+        total->tirsTotal[m] += stats->tirsTotal[m];
+        if (stats->tirsMin[m] < total->tirsMin[m])
+        {
+            total->tirsMin[m] = stats->tirsMin[m];
+        }
+        if (stats->tirsMax[m] > total->tirsMax[m])
+        {
+            total->tirsMax[m] = stats->tirsMax[m];
+        }
+    }
+}
+
+static void ecrireCsv(const Statistiques *total)
+{
+    printf("statistique,manche,valeur\n");
+    printf("matchs,total,%lld\n", total->matchs);
+    printf("victoires_joueur,total,%lld\n", total->victoiresJoueur);
+    printf("victoires_ordi,total,%lld\n", total->matchs - total->victoiresJoueur);
+    printf("taux_victoire_joueur,total,%.6f\n", total->matchs ? (double)total->victoiresJoueur / total->matchs : 0.0);
+
+    for (int m = 0; m < NB_MANCHES; m++)
+    {
+        long long jouees = total->manchesJouees[m];
+        printf("manches_jouees,%d,%lld\n", m + 1, jouees);
+        printf("defaites_joueur,%d,%lld\n", m + 1, total->defaitesJoueur[m]);
+        printf("tirs_moyens,%d,%.4f\n", m + 1, jouees ? (double)total->tirsTotal[m] / jouees : 0.0);
+        printf("tirs_min,%d,%d\n", m + 1, jouees ? total->tirsMin[m] : 0);
+        printf("tirs_max,%d,%d\n", m + 1, total->tirsMax[m]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long long matchs = 10000000;
+    long nbThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t graine = (uint64_t)time(NULL);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:ov")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            matchs = atoll(optarg);
+            break;
+        case 't':
+            nbThreads = atol(optarg);
+            break;
+        case 's':
+            graine = strtoull(optarg, NULL, 10);
+            break;
+        case 'o':
+            avecObjets = true;
+            break;
+        case 'v':
+            parVoies = true;
+            break;
+        default:
+            fprintf(stderr, "Usage : %s [-n matchs] [-t threads] [-s graine] [-o | -v]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (avecObjets && parVoies)
+    {
+        fprintf(stderr, "Le mode par voies (-v) ne joue pas les objets (-o).\n");
+        return 1;
+    }
+    if (nbThreads < 1)
+    {
+        nbThreads = 1;
+    }
+    if (nbThreads > MAX_THREADS)
+    {
+        nbThreads = MAX_THREADS;
+    }
+
+    Travailleur *travailleurs = aligned_alloc(64, sizeof(Travailleur) * nbThreads);
+    pthread_t threads[MAX_THREADS];
+    if (travailleurs == NULL)
+    {
+        fprintf(stderr, "Erreur d'allocation des travailleurs.\n");
+        return 1;
+    }
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    // Une seule graine, découpée en flux disjoints : aucun thread ne partage d'état aléatoire
+    Alea flux;
+    aleaInit(&flux, graine);
+    for (long t = 0; t < nbThreads; t++)
+    {
+        initialiserStatistiques(&travailleurs[t].stats);
+        travailleurs[t].alea = flux;
+        aleaSaut(&flux);
+        travailleurs[t].matchsAJouer = matchs / nbThreads + (t < matchs % nbThreads ? 1 : 0);
+        if (pthread_create(&threads[t], NULL, travailler, &travailleurs[t]) != 0)
+        {
+            fprintf(stderr, "Impossible de créer le thread %ld.\n", t);
+            return 1;
+        }
+    }
+
+    Statistiques total;
+    initialiserStatistiques(&total);
+    for (long t = 0; t < nbThreads; t++)
+    {
+        pthread_join(threads[t], NULL);
+        fusionnerStatistiques(&total, &travailleurs[t].stats);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    double duree = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+
+    ecrireCsv(&total);
+    fprintf(stderr, "%lld matchs en %.3f s sur %ld threads%s (%.0f matchs/s), graine %llu\n",
+            total.matchs, duree, nbThreads, parVoies ? " par voies" : "", duree > 0 ? total.matchs / duree : 0.0,
+            (unsigned long long)graine);
+
+    free(travailleurs);
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "textfield.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#define TEXT_FIELD_PADDING 8
+
+void textFieldBegin(TextField *field, SDL_Rect rect, size_t maxLength)
+{
+    field->text[0] = '\0';
+    field->length = 0;
+    field->maxLength = maxLength < sizeof(field->text) - 2 ? maxLength : sizeof(field->text) - 2; // place du curseur
+    field->rect = rect;
+    SDL_SetTextInputRect(&field->rect);
+    SDL_StartTextInput();
+}
+
+void textFieldEnd(TextField *field)
+{
+    (void)field;
+    SDL_StopTextInput();
+}
+
+// Ajoute les caractères entiers qui tiennent encore ; un caractère UTF-8 n'est jamais coupé
+static bool appendText(TextField *field, const char *text)
+{
+    size_t added = 0;
+    while (text[added] != '\0')
+    {
+        size_t next = added + 1;
+        while ((text[next] & 0xC0) == 0x80)
+        {
+            next++;
+        }
+        if (field->length + next > field->maxLength)
+        {
+            break;
+        }
+        added = next;
+    }
+    memcpy(field->text + field->length, text, added);
+    field->length += added;
+    field->text[field->length] = '\0';
+    return added > 0;
+}
+
+// Retire le dernier caractère, octets de continuation UTF-8 compris
+static bool removeLast(TextField *field)
+{
+    if (field->length == 0)
+    {
+        return false;
+    }
+    do
+    {
+        field->length--;
+    } while (field->length > 0 && (field->text[field->length] & 0xC0) == 0x80);
+    field->text[field->length] = '\0';
+    return true;
+}
+
+// Retire les blancs du début et de la fin, comme le journal des scores le fera du nom ;
+// un texte fait seulement de blancs reste tel quel et n'est pas validé
+static bool trimText(TextField *field)
+{
+    size_t start = 0;
+    size_t end = field->length;
+    while (start < end && isspace((unsigned char)field->text[start]))
+    {
+        start++;
+    }
+    while (end > start && isspace((unsigned char)field->text[end - 1]))
+    {
+        end--;
+    }
+    if (start == end)
+    {
+        return false;
+    }
+    memmove(field->text, field->text + start, end - start);
+    field->length = end - start;
+    field->text[field->length] = '\0';
+    return true;
+}
+
+TextFieldResult textFieldHandleEvent(TextField *field, const SDL_Event *e)
+{
+    if (e->type == SDL_TEXTINPUT)
+    {
+        return appendText(field, e->text.text) ? TEXT_FIELD_CHANGED : TEXT_FIELD_UNCHANGED;
+    }
+    if (e->type != SDL_KEYDOWN)
+    {
+        return TEXT_FIELD_UNCHANGED;
+    }
+
+    switch (e->key.keysym.sym)
+    {
+    case SDLK_BACKSPACE:
+        return removeLast(field) ? TEXT_FIELD_CHANGED : TEXT_FIELD_UNCHANGED;
+    case SDLK_RETURN:
+    case SDLK_KP_ENTER:
+        return trimText(field) ? TEXT_FIELD_SUBMITTED : TEXT_FIELD_UNCHANGED;
+    case SDLK_ESCAPE:
+        return TEXT_FIELD_CANCELLED;
+    default:
+        return TEXT_FIELD_UNCHANGED;
+    }
+}
+
+void textFieldRender(SDL_Renderer *renderer, TextField *field, TTF_Font *font, const char *prompt)
+{
+    SDL_Color white = {255, 255, 255, 255};
+    renderCachedText(renderer, &field->prompt, prompt, field->rect.x, field->rect.y - TTF_FontHeight(font) - TEXT_FIELD_PADDING, font, white);
+
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDrawRect(renderer, &field->rect);
+
+    // Le curseur fait que la chaîne n'est jamais vide : SDL_ttf refuse de rendre ""
+    char shown[TEXT_CACHE_MAX];
+    memcpy(shown, field->text, field->length);
+    shown[field->length] = '_';
+    shown[field->length + 1] = '\0';
+    int y = field->rect.y + (field->rect.h - TTF_FontHeight(font)) / 2;
+    renderCachedText(renderer, &field->value, shown, field->rect.x + TEXT_FIELD_PADDING, y, font, white);
+}
+
+void textFieldFree(TextField *field)
+{
+    freeTextCache(&field->prompt, 1);
+    freeTextCache(&field->value, 1);
+}
@@ -0,0 +1,42 @@
+#ifndef TEXTFIELD_H
+#define TEXTFIELD_H
+
+// Champ de saisie dans la fenêtre : le texte arrive par les événements SDL_TEXTINPUT (UTF-8,
+// clavier virtuel et méthodes de saisie compris) et se modifie au clavier. Rien ne bloque :
+// la boucle d'affichage passe chaque événement au champ puis continue.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stddef.h>
+
+#include "grid.h"
+
+typedef enum
+{
+    TEXT_FIELD_UNCHANGED,
+    TEXT_FIELD_CHANGED,   // texte modifié : à redessiner
+    TEXT_FIELD_SUBMITTED, // Entrée sur un texte qui n'est pas fait que de blancs, débarrassé de ceux des bords
+    TEXT_FIELD_CANCELLED  // Échap
+} TextFieldResult;
+
+typedef struct
+{
+    char text[TEXT_CACHE_MAX];
+    size_t length;    // en octets
+    size_t maxLength; // en octets, sans le '\0' ; jamais un caractère coupé
+    SDL_Rect rect;    // cadre du champ
+    TextCache prompt;
+    TextCache value;
+} TextField;
+
+// Vide le champ et démarre la saisie de texte de SDL (le système place sa fenêtre de saisie près de rect)
+void textFieldBegin(TextField *field, SDL_Rect rect, size_t maxLength);
+void textFieldEnd(TextField *field);
+
+TextFieldResult textFieldHandleEvent(TextField *field, const SDL_Event *e);
+
+// L'invite au-dessus du cadre, le texte et un curseur dedans ; textures recréées seulement quand ils changent
+void textFieldRender(SDL_Renderer *renderer, TextField *field, TTF_Font *font, const char *prompt);
+void textFieldFree(TextField *field);
+
+#endif
@@ -0,0 +1,208 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "trace.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TRACE_CAPACITE 1024 // puissance de 2
+#define TRACE_TEXTE_MAX 160
+
+// File bornée à plusieurs producteurs et un seul consommateur : chaque case porte un numéro
+// de séquence qui dit si elle est libre pour l'écriture numéro n (sequence == n)
+// ou prête à être lue (sequence == n + 1).
+typedef struct
+{
+    atomic_size_t sequence;
+    unsigned char niveau;
+    unsigned char categorie;
+    char texte[TRACE_TEXTE_MAX];
+} EntreeTrace;
+
+static EntreeTrace anneau[TRACE_CAPACITE];
+static atomic_size_t tete;    // prochaine écriture, partagée par les producteurs
+static size_t queue;          // prochaine lecture, propre au thread d'écriture
+static atomic_bool actif;
+static atomic_bool arret;
+static atomic_ulong perdues;
+static pthread_t thread;
+
+// Anneau vide : le thread d'écriture dort sur reveil après avoir levé endormi. Seul le
+// producteur qui trouve endormi levé prend le verrou pour le réveiller ; les autres ne
+// font qu'une lecture atomique de plus.
+static atomic_bool endormi;
+static pthread_mutex_t verrou = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reveil = PTHREAD_COND_INITIALIZER;
+
+static const char *nomsCategories[TRACE_NB_CATEGORIES] = {
+    [TRACE_REGLES] = "règles",
+    [TRACE_IA] = "ia",
+    [TRACE_ENTREES] = "entrées",
+    [TRACE_RENDU] = "rendu",
+};
+
+static void imprimer(int niveau, int categorie, const char *texte)
+{
+    // Avertissements et erreurs sur stderr, le reste sur stdout
+    FILE *sortie = niveau >= TRACE_NIVEAU_AVERTISSEMENT ? stderr : stdout;
+    fprintf(sortie, "[%s] %s\n", nomsCategories[categorie], texte);
+}
+
+// Vrai si la prochaine trace à lire est publiée
+static bool prete(void)
+{
+    return atomic_load(&anneau[queue & (TRACE_CAPACITE - 1)].sequence) == queue + 1;
+}
+
+// Lit toutes les traces prêtes, retourne leur nombre
+static int vider(void)
+{
+    int lues = 0;
+    for (;;)
+    {
+        EntreeTrace *entree = &anneau[queue & (TRACE_CAPACITE - 1)];
+        if (atomic_load_explicit(&entree->sequence, memory_order_acquire) != queue + 1)
+        {
+            break;
+        }
+        imprimer(entree->niveau, entree->categorie, entree->texte);
+        atomic_store_explicit(&entree->sequence, queue + TRACE_CAPACITE, memory_order_release);
+        queue++;
+        lues++;
+    }
+    if (lues > 0)
+    {
+        fflush(stdout);
+    }
+    return lues;
+}
+
+static void *ecrire(void *argument)
+{
+    (void)argument;
+    while (!atomic_load_explicit(&arret, memory_order_acquire))
+    {
+        if (vider() > 0)
+        {
+            continue;
+        }
+        pthread_mutex_lock(&verrou);
+        // endormi est levé avant de relire la case : une trace publiée entre-temps est soit
+        // vue ici, soit suivie d'un réveil par son producteur (accès séquentiellement cohérents)
+        atomic_store(&endormi, true);
+        while (atomic_load(&endormi) && !prete() && !atomic_load(&arret))
+        {
+            pthread_cond_wait(&reveil, &verrou);
+        }
+        atomic_store(&endormi, false);
+        pthread_mutex_unlock(&verrou);
+    }
+    vider();
+    return NULL;
+}
+
+static void reveiller(void)
+{
+    pthread_mutex_lock(&verrou);
+    pthread_cond_signal(&reveil);
+    pthread_mutex_unlock(&verrou);
+}
+
+bool traceDemarrer(void)
+{
+    if (atomic_load(&actif))
+    {
+        return true;
+    }
+    for (size_t i = 0; i < TRACE_CAPACITE; i++)
+    {
+        atomic_init(&anneau[i].sequence, i);
+    }
+    atomic_store(&tete, 0);
+    queue = 0;
+    atomic_store(&arret, false);
+    atomic_store(&endormi, false);
+    if (pthread_create(&thread, NULL, ecrire, NULL) != 0)
+    {
+        fprintf(stderr, "Impossible de créer le thread des traces : écriture directe.\n");
+        return false;
+    }
+    atomic_store(&actif, true);
+    return true;
+}
+
+void traceArreter(void)
+{
+    if (!atomic_load(&actif))
+    {
+        return;
+    }
+    atomic_store(&arret, true);
+    reveiller();
+    pthread_join(thread, NULL);
+    atomic_store(&actif, false);
+
+    unsigned long nb = atomic_load(&perdues);
+    if (nb > 0)
+    {
+        fprintf(stderr, "%lu trace(s) perdue(s), anneau plein.\n", nb);
+    }
+}
+
+void traceEcrire(int niveau, CategorieTrace categorie, const char *format, ...)
+{
+    va_list arguments;
+    va_start(arguments, format);
+
+    if (!atomic_load_explicit(&actif, memory_order_acquire))
+    {
+        char texte[TRACE_TEXTE_MAX];
+        vsnprintf(texte, sizeof(texte), format, arguments);
+        va_end(arguments);
+        imprimer(niveau, categorie, texte);
+        return;
+    }
+
+    // Réserve une case : si elle n'a pas encore été lue depuis le tour précédent, l'anneau est plein
+    size_t position = atomic_load_explicit(&tete, memory_order_relaxed);
+    EntreeTrace *entree;
+    for (;;)
+    {
+        entree = &anneau[position & (TRACE_CAPACITE - 1)];
+        size_t sequence = atomic_load_explicit(&entree->sequence, memory_order_acquire);
+        intptr_t ecart = (intptr_t)sequence - (intptr_t)position;
+        if (ecart == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&tete, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (ecart < 0)
+        {
+            atomic_fetch_add_explicit(&perdues, 1, memory_order_relaxed);
+            va_end(arguments);
+            return;
+        }
+        else
+        {
+            position = atomic_load_explicit(&tete, memory_order_relaxed);
+        }
+    }
+
+    entree->niveau = (unsigned char)niveau;
+    entree->categorie = (unsigned char)categorie;
+    vsnprintf(entree->texte, sizeof(entree->texte), format, arguments);
+    va_end(arguments);
+    atomic_store(&entree->sequence, position + 1);
+
+    // Anneau passé de vide à non vide : un seul producteur réveille le thread d'écriture
+    if (atomic_load(&endormi) && atomic_exchange(&endormi, false))
+    {
+        reveiller();
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Traces de diagnostic par niveau et par catégorie, sans dépendance à SDL.
+// Un appel formate le message dans un anneau sans verrou et rend la main : l'écriture dans
+// la console est faite par un thread de fond, qui dort tant que l'anneau est vide. Anneau plein : la trace est perdue et comptée,
+// le thread appelant n'attend jamais.
+// Les niveaux inférieurs à TRACE_NIVEAU_MIN disparaissent à la compilation : le débogage
+// n'est compilé qu'à la demande (make NIVEAU_TRACE=0), make NIVEAU_TRACE=4 retire toutes les traces.
+
+#include <stdbool.h>
+
+#define TRACE_NIVEAU_DEBUG 0
+#define TRACE_NIVEAU_INFO 1
+#define TRACE_NIVEAU_AVERTISSEMENT 2
+#define TRACE_NIVEAU_ERREUR 3
+#define TRACE_NIVEAU_AUCUN 4
+
+#ifndef TRACE_NIVEAU_MIN
+#define TRACE_NIVEAU_MIN TRACE_NIVEAU_INFO
+#endif
+
+typedef enum
+{
+    TRACE_REGLES,
+    TRACE_IA,
+    TRACE_ENTREES,
+    TRACE_RENDU,
+    TRACE_NB_CATEGORIES
+} CategorieTrace;
+
+// Vrai si les traces de ce niveau sont compilées : permet de sauter la préparation d'un message
+#define TRACE_ACTIVE(niveau) ((niveau) >= TRACE_NIVEAU_MIN)
+
+#define TRACER(niveau, categorie, ...)                      \
+    do                                                      \
+    {                                                       \
+        if (TRACE_ACTIVE(niveau))                           \
+        {                                                   \
+            traceEcrire((niveau), (categorie), __VA_ARGS__); \
+        }                                                   \
+    } while (0)
+
+#define TRACE_DEBUG(categorie, ...) TRACER(TRACE_NIVEAU_DEBUG, categorie, __VA_ARGS__)
+#define TRACE_INFO(categorie, ...) TRACER(TRACE_NIVEAU_INFO, categorie, __VA_ARGS__)
+#define TRACE_AVERTIR(categorie, ...) TRACER(TRACE_NIVEAU_AVERTISSEMENT, categorie, __VA_ARGS__)
+#define TRACE_ERREUR(categorie, ...) TRACER(TRACE_NIVEAU_ERREUR, categorie, __VA_ARGS__)
+
+// Lance le thread d'écriture. Sans lui (outils, benchmarks), les traces sont écrites directement.
+bool traceDemarrer(void);
+
+// Écrit les traces en attente puis arrête le thread
+void traceArreter(void);
+
+// Utiliser les macros ci-dessus plutôt que cette fonction. Le message n'a pas de '\n' final.
+#ifdef __GNUC__
+__attribute__((format(printf, 3, 4)))
+#endif
+void traceEcrire(int niveau, CategorieTrace categorie, const char *format, ...);
+
+#endif